@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/event_system.hpp"
+
+namespace {
+
+struct Tick {
+  std::uint64_t value = 0;
+};
+
+struct Other {};
+
+struct Counter {
+  std::uint64_t total = 0;
+
+  void on_tick(const Tick& tick) { benchmark::DoNotOptimize(total += tick.value); }
+};
+
+/// the usual runtime dispatch: handlers found by type_index, called through std::function.
+class FunctionMapDispatcher {
+  std::unordered_map<std::type_index, std::vector<std::function<void(const void*)>>> handlers_;
+
+ public:
+  template <typename Event, typename F>
+  void subscribe(F handler) {
+    handlers_[typeid(Event)].emplace_back([handler](const void* event) mutable {
+      handler(*static_cast<const Event*>(event));
+    });
+  }
+
+  template <typename Event>
+  void emit(const Event& event) {
+    const auto found = handlers_.find(typeid(Event));
+    if (found == handlers_.end()) {
+      return;
+    }
+    for (auto& handler : found->second) {
+      handler(&event);
+    }
+  }
+};
+
+}  // namespace
+
+/// events/sec, with `range(0)` handlers each.
+template <typename SharedMutex>
+static void benchmark_event_system_emit(benchmark::State& state)
+{
+  tpp::BasicEventSystem<SharedMutex, Other, Tick> events;
+  std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+  for (auto& counter : counters) {
+    events.template subscribe<Tick, &Counter::on_tick>(counter);
+  }
+
+  Tick tick{1};
+  for (auto _ : state)
+  {
+    events.emit(tick);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_event_system_emit, tpp::SharedSpinMutex)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK_TEMPLATE(benchmark_event_system_emit, tpp::NoLock)->Arg(1)->Arg(10)->Arg(100);
+
+static void benchmark_function_map_emit(benchmark::State& state)
+{
+  FunctionMapDispatcher events;
+  std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+  for (auto& counter : counters) {
+    events.subscribe<Tick>([&counter](const Tick& tick) { counter.on_tick(tick); });
+  }
+
+  Tick tick{1};
+  for (auto _ : state)
+  {
+    events.emit(tick);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmark_function_map_emit)->Arg(1)->Arg(10)->Arg(100);
+
+/// queued delivery: the time includes draining the pool.
+static void benchmark_event_system_post(benchmark::State& state)
+{
+  std::vector<Counter> counters(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state)
+  {
+    tpp::ThreadPool pool{2};
+    tpp::EventSystem<Other, Tick> events{pool};
+    for (auto& counter : counters) {
+      events.subscribe<Tick, &Counter::on_tick>(counter);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+      events.post(Tick{1});
+    }
+    pool.shutdown();
+  }
+
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(benchmark_event_system_post)->Arg(1)->Arg(10)->Arg(100)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,143 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/flat_hash_map.hpp"
+#include "toypp/flatmap.hpp"
+
+namespace {
+
+using key_type = std::uint64_t;
+
+auto make_keys(std::size_t count, std::uint64_t seed) -> std::vector<key_type> {
+  std::mt19937_64 rng{seed};
+  std::vector<key_type> keys(count);
+  for (auto& key : keys) {
+    key = rng();
+  }
+  return keys;
+}
+
+template <typename K, typename V, typename C>
+void insert_into(std::map<K, V, C>& map, K key, V value) { map.emplace(key, value); }
+
+template <typename K, typename V, typename H, typename E>
+void insert_into(std::unordered_map<K, V, H, E>& map, K key, V value) { map.emplace(key, value); }
+
+template <typename Map, typename K, typename V>
+void insert_into(Map& map, K key, V value) { map.insert(key, value); }
+
+template <typename K, typename V, typename C>
+bool lookup(const std::map<K, V, C>& map, const K& key) { return map.find(key) != map.end(); }
+
+template <typename K, typename V, typename H, typename E>
+bool lookup(const std::unordered_map<K, V, H, E>& map, const K& key) { return map.find(key) != map.end(); }
+
+template <typename Map, typename K>
+bool lookup(const Map& map, const K& key) { return map.at(key) != nullptr; }
+
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+};
+
+}  // namespace
+
+/// builds a map of `range(0)` random keys.
+template <typename Map>
+static void benchmark_insert(benchmark::State& state)
+{
+  const auto keys = make_keys(static_cast<std::size_t>(state.range(0)), 1);
+
+  for (auto _ : state)
+  {
+    Map map;
+    for (const auto key : keys) {
+      insert_into(map, key, key);
+    }
+    benchmark::DoNotOptimize(&map);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(benchmark_insert, tpp::FlatHashMap<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_insert, std::unordered_map<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_insert, std::map<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+// quadratic: stops at 64K keys.
+BENCHMARK_TEMPLATE(benchmark_insert, tpp::FlatMap<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 16);
+
+/// looks up `range(0)` keys in random order, half of them missing.
+template <typename Map>
+static void benchmark_lookup(benchmark::State& state)
+{
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto keys = make_keys(count, 1);
+  auto probes = make_keys(count, 2);
+  for (std::size_t index = 0; index < count; index += 2) {
+    probes[index] = keys[(index * 7919) % count];
+  }
+
+  Map map;
+  for (const auto key : keys) {
+    insert_into(map, key, key);
+  }
+
+  std::size_t next = 0;
+  std::size_t hits = 0;
+  for (auto _ : state)
+  {
+    hits += lookup(map, probes[next]);
+    next = (next + 1 == count) ? 0 : next + 1;
+  }
+
+  benchmark::DoNotOptimize(hits);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_lookup, tpp::FlatHashMap<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_lookup, std::unordered_map<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_lookup, std::map<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_lookup, tpp::FlatMap<key_type, key_type>)->RangeMultiplier(16)->Range(1 << 10, 1 << 16);
+
+/// string keys looked up through a `std::string_view`: heterogeneous vs building a `std::string`.
+template <bool Heterogeneous>
+static void benchmark_string_lookup(benchmark::State& state)
+{
+  std::vector<std::string> names;
+  for (std::size_t index = 0; index < 4096; ++index) {
+    names.push_back("service.endpoint." + std::to_string(index * 7919));
+  }
+
+  tpp::FlatHashMap<std::string, int, StringHash, std::equal_to<>> flat;
+  std::unordered_map<std::string, int> unordered;
+  for (const auto& name : names) {
+    flat.insert(name, 1);
+    unordered.emplace(name, 1);
+  }
+
+  std::size_t next = 0;
+  std::size_t hits = 0;
+  for (auto _ : state)
+  {
+    const std::string_view name = names[next];
+    if constexpr (Heterogeneous) {
+      hits += flat.contains(name);
+    } else {
+      hits += unordered.count(std::string(name));
+    }
+    next = (next + 1) % names.size();
+  }
+
+  benchmark::DoNotOptimize(hits);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_string_lookup, true);
+BENCHMARK_TEMPLATE(benchmark_string_lookup, false);
+
+BENCHMARK_MAIN();
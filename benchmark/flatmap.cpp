@@ -0,0 +1,149 @@
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/flatmap.hpp"
+#include "toypp/frozen_flatmap.hpp"
+#include "toypp/soa_container.hpp"
+
+namespace {
+
+using key_type = std::uint64_t;
+using map_type = tpp::FlatMap<key_type, key_type>;
+using pairs_type = std::vector<std::pair<key_type, key_type>>;
+
+auto make_pairs(std::size_t count, std::uint64_t seed) -> pairs_type {
+  std::mt19937_64 rng{seed};
+  pairs_type pairs(count);
+  for (auto& [key, value] : pairs) {
+    key = rng();
+    value = key;
+  }
+  return pairs;
+}
+
+}  // namespace
+
+/// builds a map of `range(0)` random pairs with one `insert` each.
+static void benchmark_build_insert(benchmark::State& state)
+{
+  const auto pairs = make_pairs(static_cast<std::size_t>(state.range(0)), 1);
+
+  for (auto _ : state)
+  {
+    map_type map;
+    map.reserve(pairs.size());
+    for (const auto& [key, value] : pairs) {
+      map.insert(key, value);
+    }
+    benchmark::DoNotOptimize(&map);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+// quadratic: stops at 64K pairs.
+BENCHMARK(benchmark_build_insert)->RangeMultiplier(8)->Range(1 << 10, 1 << 16);
+
+/// builds a map of `range(0)` random pairs with one sort.
+static void benchmark_build_from_unsorted(benchmark::State& state)
+{
+  const auto pairs = make_pairs(static_cast<std::size_t>(state.range(0)), 1);
+
+  for (auto _ : state)
+  {
+    map_type map(tpp::from_unsorted, pairs);
+    benchmark::DoNotOptimize(&map);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(benchmark_build_from_unsorted)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+
+/// grows a map to `range(0)` pairs by `insert_bulk` batches of 4096.
+static void benchmark_build_insert_bulk(benchmark::State& state)
+{
+  constexpr std::size_t k_batch = 4096;
+  const auto pairs = make_pairs(static_cast<std::size_t>(state.range(0)), 1);
+
+  for (auto _ : state)
+  {
+    map_type map;
+    map.reserve(pairs.size());
+    for (std::size_t first = 0; first < pairs.size(); first += k_batch) {
+      const auto last = std::min(first + k_batch, pairs.size());
+      map.insert_bulk(pairs_type(pairs.begin() + first, pairs.begin() + last));
+    }
+    benchmark::DoNotOptimize(&map);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(benchmark_build_insert_bulk)->RangeMultiplier(8)->Range(1 << 12, 1 << 19);
+
+/// lookup latency over `range(0)` keys, in random order, half of them missing.
+template <typename Map>
+static void benchmark_lookup(benchmark::State& state)
+{
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto pairs = make_pairs(count, 1);
+  const Map map(tpp::from_unsorted, pairs);
+
+  std::vector<key_type> probes;
+  std::mt19937_64 rng{2};
+  for (std::size_t index = 0; index < std::min<std::size_t>(count, 1 << 20); ++index) {
+    probes.push_back(index % 2 ? rng() : pairs[rng() % count].first);
+  }
+
+  std::size_t next = 0;
+  std::size_t hits = 0;
+  for (auto _ : state)
+  {
+    const bool hit = map.at(probes[next]) != nullptr;
+    hits += hit;
+    // the next probe depends on this result: latency, not throughput.
+    next += 1 + hit;
+    if (next >= probes.size()) next = 0;
+  }
+
+  benchmark::DoNotOptimize(hits);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_lookup, map_type)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)->Arg(10000000);
+BENCHMARK_TEMPLATE(benchmark_lookup, tpp::FrozenFlatMap<key_type, key_type>)->Arg(1000)->Arg(10000)->Arg(100000)->Arg(1000000)->Arg(10000000);
+
+/// a value big enough that an array-of-pairs search strides over cache lines.
+struct LargeValue {
+  std::uint64_t words[32] = {};
+};
+
+/// hit lookups over `range(0)` keys mapped to `LargeValue`s.
+template <typename Map>
+static void benchmark_lookup_large_value(benchmark::State& state)
+{
+  const auto count = static_cast<std::size_t>(state.range(0));
+  const auto pairs = make_pairs(count, 1);
+
+  std::vector<std::pair<key_type, LargeValue>> entries;
+  for (const auto& [key, value] : pairs) {
+    entries.emplace_back(key, LargeValue{{value}});
+  }
+  const Map map(tpp::from_unsorted, std::move(entries));
+
+  std::mt19937_64 rng{2};
+  std::uint64_t sum = 0;
+  for (auto _ : state)
+  {
+    sum += map.at(pairs[rng() % count].first)->words[0];
+  }
+
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_lookup_large_value, tpp::FlatMap<key_type, LargeValue>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(benchmark_lookup_large_value, tpp::SoAFlatMap<key_type, LargeValue>)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/hook_system.hpp"
+
+namespace {
+
+struct Counter {
+  std::uint64_t total = 0;
+
+  void on_call(std::uint64_t value) { benchmark::DoNotOptimize(total += value); }
+};
+
+}  // namespace
+
+/// cost of a call site: compiled out, no handler (flag check), `range(0)` handlers.
+template <bool Enabled>
+static void benchmark_hook_call(benchmark::State& state)
+{
+  tpp::BasicHook<Enabled, std::uint64_t> hook;
+  Counter counters[8];
+  if constexpr (Enabled) {
+    for (std::int64_t index = 0; index < state.range(0); ++index) {
+      hook.template add<&Counter::on_call>(counters[index]);
+    }
+  }
+
+  std::uint64_t value = 0;
+  for (auto _ : state)
+  {
+    hook(++value);
+    benchmark::DoNotOptimize(value);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_hook_call, false)->Arg(0);
+BENCHMARK_TEMPLATE(benchmark_hook_call, true)->Arg(0)->Arg(1)->Arg(8);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/flatmap.hpp"
+#include "toypp/perfect_hash_map.hpp"
+
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr std::pair<std::string_view, int> k_headers[] = {
+    {"accept"sv, 0}, {"accept-charset"sv, 1}, {"accept-encoding"sv, 2}, {"accept-language"sv, 3},
+    {"accept-ranges"sv, 4}, {"age"sv, 5}, {"allow"sv, 6}, {"authorization"sv, 7},
+    {"cache-control"sv, 8}, {"connection"sv, 9}, {"content-disposition"sv, 10}, {"content-encoding"sv, 11},
+    {"content-language"sv, 12}, {"content-length"sv, 13}, {"content-location"sv, 14}, {"content-range"sv, 15},
+    {"content-type"sv, 16}, {"cookie"sv, 17}, {"date"sv, 18}, {"etag"sv, 19},
+    {"expect"sv, 20}, {"expires"sv, 21}, {"from"sv, 22}, {"host"sv, 23},
+    {"if-match"sv, 24}, {"if-modified-since"sv, 25}, {"if-none-match"sv, 26}, {"if-range"sv, 27},
+    {"if-unmodified-since"sv, 28}, {"last-modified"sv, 29}, {"link"sv, 30}, {"location"sv, 31},
+    {"max-forwards"sv, 32}, {"proxy-authenticate"sv, 33}, {"proxy-authorization"sv, 34}, {"range"sv, 35},
+    {"referer"sv, 36}, {"refresh"sv, 37}, {"retry-after"sv, 38}, {"server"sv, 39},
+    {"set-cookie"sv, 40}, {"strict-transport-security"sv, 41}, {"transfer-encoding"sv, 42}, {"user-agent"sv, 43},
+    {"vary"sv, 44}, {"via"sv, 45}, {"www-authenticate"sv, 46}, {"x-forwarded-for"sv, 47},
+};
+
+constexpr auto k_perfect = tpp::make_perfect_hash_map(k_headers);
+
+/// header names as they come off the wire, a quarter of them unknown.
+auto make_probes() -> std::vector<std::string> {
+  std::mt19937 rng{1};
+  std::vector<std::string> probes;
+  for (std::size_t index = 0; index < 4096; ++index) {
+    const auto& name = k_headers[rng() % std::size(k_headers)].first;
+    probes.emplace_back(index % 4 == 0 ? "x-custom-" + std::string(name) : std::string(name));
+  }
+  return probes;
+}
+
+const int* lookup(const decltype(k_perfect)& map, std::string_view key) { return map.at(key); }
+const int* lookup(const tpp::FlatMap<std::string_view, int>& map, std::string_view key) { return map.at(key); }
+
+const int* lookup(const std::unordered_map<std::string_view, int>& map, std::string_view key) {
+  const auto it = map.find(key);
+  return it == map.end() ? nullptr : &it->second;
+}
+
+template <typename Map>
+auto make_map() -> Map {
+  if constexpr (std::is_same_v<Map, std::remove_cv_t<decltype(k_perfect)>>) {
+    return k_perfect;
+  } else if constexpr (std::is_same_v<Map, tpp::FlatMap<std::string_view, int>>) {
+    return Map(tpp::from_unsorted, k_headers);
+  } else {
+    return Map(std::begin(k_headers), std::end(k_headers));
+  }
+}
+
+}  // namespace
+
+/// looks up HTTP header names (48 known ones).
+template <typename Map>
+static void benchmark_lookup(benchmark::State& state)
+{
+  const auto map = make_map<Map>();
+  const auto probes = make_probes();
+
+  std::size_t next = 0;
+  int sum = 0;
+  for (auto _ : state)
+  {
+    if (const auto* value = lookup(map, probes[next])) {
+      sum += *value;
+    }
+    next = (next + 1) % probes.size();
+  }
+
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_lookup, std::remove_cv_t<decltype(k_perfect)>);
+BENCHMARK_TEMPLATE(benchmark_lookup, tpp::FlatMap<std::string_view, int>);
+BENCHMARK_TEMPLATE(benchmark_lookup, std::unordered_map<std::string_view, int>);
+
+BENCHMARK_MAIN();
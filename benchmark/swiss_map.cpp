@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/flat_hash_map.hpp"
+#include "toypp/swiss_map.hpp"
+
+namespace {
+
+using key_type = std::uint64_t;
+
+constexpr std::size_t k_capacity = 1 << 18;
+
+template <typename Group>
+using swiss_map_type = tpp::SwissMap<key_type, key_type, std::hash<key_type>, std::equal_to<key_type>, Group>;
+
+auto make_keys(std::size_t count, std::uint64_t seed) -> std::vector<key_type> {
+  std::mt19937_64 rng{seed};
+  std::vector<key_type> keys(count);
+  for (auto& key : keys) {
+    key = rng();
+  }
+  return keys;
+}
+
+}  // namespace
+
+/**
+ * lookups in a table of `k_capacity` slots filled to `range(0)`/1000,
+ * all hits (`range(1)` = 1) or all misses (0).
+ */
+template <typename Map>
+static void benchmark_lookup(benchmark::State& state)
+{
+  const auto count = k_capacity * static_cast<std::size_t>(state.range(0)) / 1000;
+  const auto keys = make_keys(count, 1);
+  auto probes = state.range(1) ? keys : make_keys(count, 2);
+  std::shuffle(probes.begin(), probes.end(), std::mt19937_64{3});
+
+  Map map;
+  map.reserve(k_capacity - k_capacity / 8);
+  for (const auto key : keys) {
+    map.insert(key, key);
+  }
+
+  std::size_t next = 0;
+  std::size_t hits = 0;
+  for (auto _ : state)
+  {
+    hits += map.contains(probes[next]);
+    next = (next + 1 == count) ? 0 : next + 1;
+  }
+
+  benchmark::DoNotOptimize(hits);
+  state.counters["load_factor"] = map.load_factor();
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define TOYPP_LOOKUP_ARGS ArgsProduct({{500, 625, 750, 875}, {1, 0}})->ArgNames({"load", "hit"})
+
+#if defined(TOYPP_SWISS_HAS_SSE2)
+BENCHMARK_TEMPLATE(benchmark_lookup, swiss_map_type<tpp::SwissSse2Group>)->TOYPP_LOOKUP_ARGS;
+#endif
+BENCHMARK_TEMPLATE(benchmark_lookup, swiss_map_type<tpp::SwissScalarGroup>)->TOYPP_LOOKUP_ARGS;
+BENCHMARK_TEMPLATE(benchmark_lookup, tpp::FlatHashMap<key_type, key_type>)->TOYPP_LOOKUP_ARGS;
+
+BENCHMARK_MAIN();
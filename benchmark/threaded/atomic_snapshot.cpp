@@ -0,0 +1,51 @@
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/atomic_snapshot.hpp"
+
+namespace {
+
+struct Config {
+  std::string name = "service";
+  std::size_t limit = 42;
+};
+
+tpp::AtomicSnapshot<Config> snapshot{tpp::make_shared<Config>()};
+
+std::shared_mutex mutex;
+tpp::SharedPtr<Config> guarded = tpp::make_shared<Config>();
+
+}  // namespace
+
+static void benchmark_atomic_snapshot_read(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    const auto guard = snapshot.read();
+    benchmark::DoNotOptimize(guard->limit);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmark_atomic_snapshot_read)->ThreadRange(1, 8)->UseRealTime();
+
+static void benchmark_shared_mutex_sharedptr_read(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    tpp::SharedPtr<Config> config;
+    {
+      std::shared_lock lock{mutex};
+      config = guarded;
+    }
+    benchmark::DoNotOptimize(config->limit);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmark_shared_mutex_sharedptr_read)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
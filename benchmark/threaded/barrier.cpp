@@ -0,0 +1,76 @@
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#if __cplusplus >= 202002L && __has_include(<barrier>)
+#include <barrier>
+#define TOYPP_BENCHMARK_STD_BARRIER 1
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/barrier.hpp"
+
+namespace {
+
+/// the textbook generation-counting barrier, as a baseline.
+class CondvarBarrier {
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::ptrdiff_t expected_;
+  std::ptrdiff_t remaining_;
+  std::uint64_t generation_ = 0;
+
+ public:
+  explicit CondvarBarrier(std::ptrdiff_t expected) : expected_(expected), remaining_(expected) {}
+
+  void arrive_and_wait() {
+    std::unique_lock lock{mutex_};
+    const auto generation = generation_;
+    if (--remaining_ == 0) {
+      remaining_ = expected_;
+      ++generation_;
+      lock.unlock();
+      cv_.notify_all();
+      return;
+    }
+    cv_.wait(lock, [&] { return generation_ != generation; });
+  }
+};
+
+template <typename Barrier>
+struct Shared {
+  static inline std::unique_ptr<Barrier> barrier;
+};
+
+}  // namespace
+
+/// time for every thread to get through one phase.
+template <typename Barrier>
+static void benchmark_barrier_round_trip(benchmark::State& state)
+{
+  using shared = Shared<Barrier>;
+  // the benchmark runner syncs its threads before and after the loop.
+  if (state.thread_index() == 0) {
+    shared::barrier = std::make_unique<Barrier>(state.threads());
+  }
+
+  for (auto _ : state)
+  {
+    shared::barrier->arrive_and_wait();
+  }
+
+  if (state.thread_index() == 0) {
+    shared::barrier.reset();
+    state.SetItemsProcessed(state.iterations());
+  }
+}
+BENCHMARK_TEMPLATE(benchmark_barrier_round_trip, tpp::Barrier)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_barrier_round_trip, tpp::BasicBarrier<tpp::EmptyCompletion, tpp::YieldWait>)->ThreadRange(2, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_barrier_round_trip, CondvarBarrier)->ThreadRange(2, 16)->UseRealTime();
+#ifdef TOYPP_BENCHMARK_STD_BARRIER
+BENCHMARK_TEMPLATE(benchmark_barrier_round_trip, std::barrier<>)->ThreadRange(2, 16)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/concurrent_hash_map.hpp"
+
+namespace {
+
+constexpr std::uint64_t k_keys = 1 << 16;
+
+struct Value {
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+};
+
+/// the cache under test, prefilled with `k_keys` entries.
+template <typename Map>
+struct Shared {
+  static inline Map map = [] {
+    Map map;
+    for (std::uint64_t key = 0; key < k_keys; ++key) {
+      map.insert_or_assign(key, Value{key, key});
+    }
+    return map;
+  }();
+};
+
+/// baseline: one `std::unordered_map` behind a reader-writer lock.
+class SharedMutexMap {
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::uint64_t, Value> map_;
+
+ public:
+  SharedMutexMap() = default;
+  SharedMutexMap(SharedMutexMap&& other) noexcept : map_(std::move(other.map_)) {}
+
+  std::optional<Value> get(std::uint64_t key) const {
+    std::shared_lock lock{mutex_};
+    const auto it = map_.find(key);
+    if (it == map_.end()) return std::nullopt;
+    return it->second;
+  }
+
+  bool insert_or_assign(std::uint64_t key, const Value& value) {
+    std::lock_guard lock{mutex_};
+    return map_.insert_or_assign(key, value).second;
+  }
+};
+
+using ShardedMap = tpp::ConcurrentHashMap<std::uint64_t, Value>;
+
+/// ConcurrentHashMap isn't movable: `Shared` builds it behind a pointer.
+struct ShardedHolder {
+  std::unique_ptr<ShardedMap> map = std::make_unique<ShardedMap>();
+
+  std::optional<Value> get(std::uint64_t key) const { return map->get(key); }
+  bool insert_or_assign(std::uint64_t key, const Value& value) { return map->insert_or_assign(key, value); }
+};
+
+/// one write every `state.range(0)` operations, the rest are reads.
+template <typename Map>
+void run_mix(benchmark::State& state)
+{
+  auto& map = Shared<Map>::map;
+  const auto write_every = static_cast<std::uint64_t>(state.range(0));
+  std::uint64_t key = 0x9E3779B97F4A7C15ull * static_cast<std::uint64_t>(state.thread_index() + 1);
+  std::uint64_t step = 0;
+
+  for (auto _ : state)
+  {
+    key = key * 6364136223846793005ull + 1442695040888963407ull;
+    const auto index = (key >> 33) % k_keys;
+    if (++step % write_every == 0) {
+      map.insert_or_assign(index, Value{index, step});
+    } else {
+      benchmark::DoNotOptimize(map.get(index));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void benchmark_concurrent_hash_map_mix(benchmark::State& state)
+{
+  run_mix<ShardedHolder>(state);
+}
+BENCHMARK(benchmark_concurrent_hash_map_mix)->Arg(2)->Arg(10)->Arg(100)->ThreadRange(1, 16)->UseRealTime();
+
+static void benchmark_shared_mutex_unordered_map_mix(benchmark::State& state)
+{
+  run_mix<SharedMutexMap>(state);
+}
+BENCHMARK(benchmark_shared_mutex_unordered_map_mix)->Arg(2)->Arg(10)->Arg(100)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
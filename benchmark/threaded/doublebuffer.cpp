@@ -4,6 +4,7 @@
 #include <benchmark/benchmark.h>
 
 #include "toypp/threaded/doublebuffer.hpp"
+#include "toypp/threaded/triplebuffer.hpp"
 
 static void benchmark_reader_writer_latency(benchmark::State& state)
 {
@@ -38,4 +39,39 @@ static void benchmark_reader_writer_latency(benchmark::State& state)
 }
 BENCHMARK(benchmark_reader_writer_latency);
 
+static void benchmark_triplebuffer_writer_latency(benchmark::State& state)
+{
+  tpp::TripleBuffer<std::uint64_t> triplebuffer{};
+  std::atomic<std::uint64_t> running{false};
+
+  std::thread thread{[&] {
+    running.store(true, std::memory_order_relaxed);
+    while (running.load(std::memory_order_relaxed))
+    {
+      if (triplebuffer.reader_arrive()) {
+        benchmark::DoNotOptimize(triplebuffer.reader_buffer());
+      }
+    }
+  }};
+
+  while (!running.load(std::memory_order_acquire))
+  {
+    benchmark::DoNotOptimize(running);
+  }
+
+  std::size_t count = 0;
+  for (auto _ : state)
+  {
+    triplebuffer.writer_buffer() = count;
+    triplebuffer.writer_publish();
+    ++count;
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  thread.join();
+
+  state.SetItemsProcessed(count);
+}
+BENCHMARK(benchmark_triplebuffer_writer_latency);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/mcs_spinmutex.hpp"
+#include "toypp/threaded/spinmutex.hpp"
+#include "toypp/threaded/ticket_spinmutex.hpp"
+
+namespace {
+
+template <typename Mutex>
+struct Shared {
+  static inline Mutex mutex;
+  static inline std::uint64_t counter = 0;
+};
+
+}  // namespace
+
+/// throughput, plus per-thread p99/max time to acquire (averaged over threads).
+template <typename Mutex>
+static void benchmark_acquire_latency(benchmark::State& state)
+{
+  using shared = Shared<Mutex>;
+  using clock = std::chrono::steady_clock;
+
+  std::vector<std::int64_t> latencies;
+  latencies.reserve(1 << 20);
+
+  for (auto _ : state)
+  {
+    const auto start = clock::now();
+    std::lock_guard lock{shared::mutex};
+    const auto acquired = clock::now();
+    benchmark::DoNotOptimize(++shared::counter);
+
+    if (latencies.size() < latencies.capacity()) {
+      latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(acquired - start).count());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  if (!latencies.empty()) {
+    const auto p99 = latencies.begin() + static_cast<std::ptrdiff_t>(latencies.size() * 99 / 100);
+    std::nth_element(latencies.begin(), p99, latencies.end());
+    const auto max = *std::max_element(p99, latencies.end());
+    state.counters["p99_ns"] = benchmark::Counter(static_cast<double>(*p99), benchmark::Counter::kAvgThreads);
+    state.counters["max_ns"] = benchmark::Counter(static_cast<double>(max), benchmark::Counter::kAvgThreads);
+  }
+}
+BENCHMARK_TEMPLATE(benchmark_acquire_latency, tpp::SpinMutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_acquire_latency, tpp::TicketSpinMutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_acquire_latency, tpp::MCSSpinMutex)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
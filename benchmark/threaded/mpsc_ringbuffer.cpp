@@ -0,0 +1,49 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/mpsc_ringbuffer.hpp"
+
+namespace {
+
+std::unique_ptr<tpp::MPSCRingBuffer> ringbuffer;
+std::unique_ptr<std::thread> consumer;
+std::atomic<bool> consuming{false};
+
+}  // namespace
+
+static void benchmark_producer_throughput(benchmark::State& state)
+{
+  if (state.thread_index() == 0) {
+    ringbuffer = std::make_unique<tpp::MPSCRingBuffer>(1 << 20);
+    consuming.store(true, std::memory_order_relaxed);
+    consumer = std::make_unique<std::thread>([] {
+      while (consuming.load(std::memory_order_relaxed)) {
+        ringbuffer->read([](tpp::Span<const char> message) { benchmark::DoNotOptimize(message.data()); });
+      }
+    });
+  }
+
+  const char message[64] = {};
+  const auto size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state)
+  {
+    ringbuffer->write(message, size);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * size);
+
+  if (state.thread_index() == 0) {
+    consuming.store(false, std::memory_order_relaxed);
+    consumer->join();
+    consumer.reset();
+    ringbuffer.reset();
+  }
+}
+BENCHMARK(benchmark_producer_throughput)->Arg(16)->Arg(60)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/pubsub_queue.hpp"
+
+/// one publisher, `range(0)` subscribers draining as fast as they can.
+template <tpp::LagPolicy Policy>
+static void benchmark_publish_fan_out(benchmark::State& state)
+{
+  tpp::PubSubQueue<std::uint64_t> pubsub_queue{1024, Policy};
+  std::atomic<bool> running{true};
+  std::atomic<std::uint64_t> deliveries{0};
+
+  std::vector<std::thread> subscribers;
+  for (std::int64_t index = 0; index < state.range(0); ++index) {
+    subscribers.emplace_back([&running, &deliveries, subscription = pubsub_queue.subscribe()]() mutable {
+      std::uint64_t received = 0;
+      while (running.load(std::memory_order_relaxed)) {
+        if (auto value = subscription.dequeue()) {
+          benchmark::DoNotOptimize(*value);
+          ++received;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+      deliveries.fetch_add(received, std::memory_order_relaxed);
+    });
+  }
+
+  std::uint64_t number = 0;
+  for (auto _ : state)
+  {
+    pubsub_queue.publish(number++);
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  for (auto& subscriber : subscribers) {
+    subscriber.join();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  // lower than items * subscribers when messages are dropped.
+  state.counters["deliveries_per_second"] = benchmark::Counter(
+      static_cast<double>(deliveries.load()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(benchmark_publish_fan_out, tpp::LagPolicy::block)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_publish_fan_out, tpp::LagPolicy::drop_oldest)->RangeMultiplier(2)->Range(1, 32)->UseRealTime();
+
+/// 4 KiB payloads: `dequeue` copies each one per subscriber, `visit` reads them in place by batches.
+template <bool InPlace>
+static void benchmark_fan_out_large_payload(benchmark::State& state)
+{
+  tpp::PubSubQueue<std::string> pubsub_queue{256};
+  std::atomic<bool> running{true};
+
+  std::vector<std::thread> subscribers;
+  for (std::int64_t index = 0; index < state.range(0); ++index) {
+    subscribers.emplace_back([&running, subscription = pubsub_queue.subscribe()]() mutable {
+      while (running.load(std::memory_order_relaxed)) {
+        std::size_t count = 0;
+        if constexpr (InPlace) {
+          count = subscription.visit([](const std::string& value) { benchmark::DoNotOptimize(value.data()); }, 64);
+        } else if (auto value = subscription.dequeue()) {
+          benchmark::DoNotOptimize(value->data());
+          count = 1;
+        }
+        if (count == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  const std::string payload(4096, 'x');
+  for (auto _ : state)
+  {
+    pubsub_queue.publish(payload);
+  }
+
+  running.store(false, std::memory_order_relaxed);
+  for (auto& subscriber : subscribers) {
+    subscriber.join();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_fan_out_large_payload, false)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_fan_out_large_payload, true)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
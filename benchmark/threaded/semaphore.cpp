@@ -0,0 +1,81 @@
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if __cplusplus >= 202002L && __has_include(<semaphore>)
+#include <semaphore>
+#define TOYPP_BENCHMARK_STD_SEMAPHORE 1
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/semaphore.hpp"
+#include "toypp/threaded/spinsemaphore.hpp"
+
+namespace {
+
+constexpr std::uint32_t k_permits = 2;
+
+/// the textbook semaphore, as a baseline with `std::counting_semaphore` semantics.
+class CondvarSemaphore {
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::uint32_t count_;
+
+ public:
+  explicit CondvarSemaphore(std::uint32_t initial) : count_(initial) {}
+
+  void acquire() {
+    std::unique_lock lock{mutex_};
+    cv_.wait(lock, [this] { return count_ != 0; });
+    --count_;
+  }
+
+  void release() {
+    {
+      std::lock_guard lock{mutex_};
+      ++count_;
+    }
+    cv_.notify_one();
+  }
+};
+
+template <typename Semaphore>
+struct Shared {
+  static inline Semaphore semaphore{k_permits};
+};
+
+template <>
+struct Shared<tpp::SpinSemaphore<k_permits>> {
+  static inline tpp::SpinSemaphore<k_permits> semaphore;
+};
+
+}  // namespace
+
+/// more threads than permits (and than cores): holders do `range(0)` units of work.
+template <typename Semaphore>
+static void benchmark_oversubscribed(benchmark::State& state)
+{
+  auto& semaphore = Shared<Semaphore>::semaphore;
+  const auto work = state.range(0);
+  std::uint64_t sink = 0;
+
+  for (auto _ : state)
+  {
+    semaphore.acquire();
+    for (std::int64_t i = 0; i < work; ++i) {
+      benchmark::DoNotOptimize(++sink);
+    }
+    semaphore.release();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_oversubscribed, tpp::Semaphore)->Arg(16)->Arg(1024)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_oversubscribed, tpp::SpinSemaphore<k_permits>)->Arg(16)->Arg(1024)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_oversubscribed, CondvarSemaphore)->Arg(16)->Arg(1024)->ThreadRange(1, 32)->UseRealTime();
+#ifdef TOYPP_BENCHMARK_STD_SEMAPHORE
+BENCHMARK_TEMPLATE(benchmark_oversubscribed, std::counting_semaphore<>)->Arg(16)->Arg(1024)->ThreadRange(1, 32)->UseRealTime();
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,66 @@
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/adaptive_mutex.hpp"
+#include "toypp/threaded/shared_spinmutex.hpp"
+#include "toypp/threaded/spinmutex.hpp"
+
+namespace {
+
+template <typename Mutex>
+struct Shared {
+  static inline Mutex mutex;
+  static inline std::uint64_t counter = 0;
+};
+
+}  // namespace
+
+template <typename Mutex>
+static void benchmark_contended_lock(benchmark::State& state)
+{
+  using shared = Shared<Mutex>;
+  const auto work = state.range(0);
+
+  for (auto _ : state)
+  {
+    std::lock_guard lock{shared::mutex};
+    for (std::int64_t i = 0; i < work; ++i) {
+      benchmark::DoNotOptimize(++shared::counter);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_contended_lock, tpp::SpinMutex)->Arg(1)->Arg(64)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_contended_lock, tpp::AdaptiveMutex)->Arg(1)->Arg(64)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_contended_lock, std::mutex)->Arg(1)->Arg(64)->ThreadRange(1, 16)->UseRealTime();
+
+// one write out of `range(0)` operations, the rest are shared reads.
+template <typename Mutex>
+static void benchmark_read_mostly(benchmark::State& state)
+{
+  using shared = Shared<Mutex>;
+  const auto write_every = state.range(0);
+  std::int64_t operation = 0;
+
+  for (auto _ : state)
+  {
+    if (++operation % write_every == 0) {
+      std::lock_guard lock{shared::mutex};
+      benchmark::DoNotOptimize(++shared::counter);
+    } else {
+      std::shared_lock lock{shared::mutex};
+      benchmark::DoNotOptimize(shared::counter);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_read_mostly, tpp::SharedSpinMutex)->Arg(100)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_read_mostly, tpp::BasicSharedSpinMutex<true>)->Arg(100)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_read_mostly, std::shared_mutex)->Arg(100)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include "toypp/threaded/spsc_ringbuffer.hpp"
+#include "toypp/threaded/wait_strategy.hpp"
+
+/// non-blocking write + read in one thread: the cost each strategy's `notify` adds to a call.
+template <typename WaitStrategy>
+static void benchmark_spsc_ringbuffer_round_trip(benchmark::State& state)
+{
+  tpp::BasicSPSCRingBuffer<WaitStrategy> ring{4096};
+  char message[64] = {};
+  char out[64];
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(ring.write(message, sizeof(message)));
+    benchmark::DoNotOptimize(ring.read(out, sizeof(out)));
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(benchmark_spsc_ringbuffer_round_trip, tpp::BusySpinWait);
+BENCHMARK_TEMPLATE(benchmark_spsc_ringbuffer_round_trip, tpp::YieldWait);
+BENCHMARK_TEMPLATE(benchmark_spsc_ringbuffer_round_trip, tpp::FutexWait);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,364 @@
+#ifndef TOYPP_CONFIG_MANAGER_HPP_
+#define TOYPP_CONFIG_MANAGER_HPP_
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "toypp/sharedptr.hpp"
+#include "toypp/threaded/atomic_snapshot.hpp"
+#include "toypp/threaded/pubsub_queue.hpp"
+
+namespace tpp {
+
+class ConfigManager;
+
+/**
+ * Typed handle of an interned config key: reading it is an array index.
+ * Only valid with the `ConfigManager` that made it.
+ */
+template <typename T>
+class ConfigKey {
+  friend class ConfigManager;
+
+  std::size_t index_ = 0;
+
+  explicit ConfigKey(std::size_t index) noexcept : index_(index) {}
+
+ public:
+  using value_type = T;
+
+  [[nodiscard]] auto index() const noexcept -> std::size_t { return index_; }
+};
+
+namespace detail {
+
+/// read-only `mmap` of a whole file (POSIX only).
+class MappedConfigFile {
+  void* data_ = nullptr;
+  std::size_t size_ = 0;
+
+ public:
+  MappedConfigFile() {}
+
+  explicit MappedConfigFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+
+    struct ::stat st{};
+    if (::fstat(fd, &st) == -1) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "fstat " + path);
+    }
+
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ != 0) {
+      data_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data_ == MAP_FAILED) {
+        const int error = errno;
+        data_ = nullptr;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "mmap " + path);
+      }
+    }
+    // the mapping stays valid without the descriptor.
+    ::close(fd);
+  }
+
+  MappedConfigFile(MappedConfigFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+  MappedConfigFile& operator=(MappedConfigFile&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      data_ = std::exchange(other.data_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~MappedConfigFile() { unmap(); }
+
+  [[nodiscard]] auto text() const noexcept -> std::string_view {
+    return data_ ? std::string_view(static_cast<const char*>(data_), size_) : std::string_view();
+  }
+
+ private:
+  void unmap() noexcept {
+    if (data_) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+    }
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Process-wide settings, read on hot paths and updated rarely.
+ *
+ * Keys are interned once into typed `ConfigKey<T>` handles, so a read is an
+ * index into the current snapshot of values: no string hashing, no lock,
+ * wait-free (`AtomicSnapshot`). Updates are copy-on-write and publish a whole
+ * new snapshot at once, so a `View` never sees half of a file load. Writers
+ * don't wait for views to go away (old snapshots are reclaimed by later
+ * updates), so a thread may update while it holds a `View`.
+ *
+ * Every changed key is announced on a `PubSubQueue` of `Change`s; a subscriber
+ * that falls behind loses the oldest notifications. One holding a `peek()`
+ * does hold writers back until it advances, so it must not update the config
+ * meanwhile.
+ *
+ * Files hold `key = value` lines (`#` starts a comment). They are `mmap`ed
+ * and only indexed on load; a value is converted when its key is interned
+ * (or right away for keys already interned). A loaded file must be replaced,
+ * not edited in place, since the mapping stays in use (POSIX only).
+ *
+ * Value types: bool, std::int64_t, double, std::string.
+ */
+class ConfigManager {
+ public:
+  using value_type = std::variant<bool, std::int64_t, double, std::string>;
+
+  /// notification: the key at `index` changed, in snapshot `version`.
+  struct Change {
+    std::size_t index = 0;
+    std::uint64_t version = 0;
+
+    template <typename T>
+    [[nodiscard]] bool is(ConfigKey<T> key) const noexcept { return key.index() == index; }
+  };
+
+  using subscription_type = PubSubQueue<Change>::Subscription;
+
+ private:
+  struct Values {
+    std::vector<value_type> values;
+    std::uint64_t version = 0;
+  };
+
+  template <typename T>
+  static constexpr bool is_value_type_v = std::is_same_v<T, bool> || std::is_same_v<T, std::int64_t>
+                                       || std::is_same_v<T, double> || std::is_same_v<T, std::string>;
+
+  mutable AtomicSnapshot<Values> snapshot_{tpp::make_shared<Values>()};
+  PubSubQueue<Change> changes_;
+
+  std::mutex writer_mutex_;
+  std::unordered_map<std::string, std::size_t> names_;
+  detail::MappedConfigFile file_;
+  std::unordered_map<std::string_view, std::string_view> file_entries_;
+
+ public:
+  /**
+   * Consistent view of every value at one point in time; references stay valid
+   * as long as the view. Meant to be short-lived: while it exists, the snapshots
+   * replaced since it was taken stay in memory.
+   */
+  class View {
+    friend class ConfigManager;
+
+    AtomicSnapshot<Values>::ReadGuard guard_;
+
+    explicit View(AtomicSnapshot<Values>& snapshot) noexcept : guard_(snapshot.read()) {}
+
+   public:
+    template <typename T>
+    [[nodiscard]] const T& get(ConfigKey<T> key) const noexcept {
+      return *std::get_if<T>(&guard_->values[key.index()]);
+    }
+
+    template <typename T>
+    const T& operator[](ConfigKey<T> key) const noexcept { return get(key); }
+
+    [[nodiscard]] auto version() const noexcept -> std::uint64_t { return guard_->version; }
+  };
+
+  /// `change_capacity`: notifications a subscriber can lag behind before losing some.
+  explicit ConfigManager(std::size_t change_capacity = 256)
+    : changes_(change_capacity, LagPolicy::drop_oldest) {}
+
+  ConfigManager(const ConfigManager&) = delete;
+  ConfigManager& operator=(const ConfigManager&) = delete;
+
+  /**
+   * Interns `name`: its value comes from the loaded file if it's there, `default_value` otherwise.
+   * Interning a known name returns the same handle.
+   *
+   * @throw std::runtime_error if `name` is known with another type, or the file's value doesn't parse.
+   */
+  template <typename T>
+  ConfigKey<T> key(std::string_view name, T default_value = T{}) {
+    static_assert(is_value_type_v<T>, "config values are bool, std::int64_t, double or std::string.");
+
+    std::lock_guard lock{writer_mutex_};
+    const auto found = names_.find(std::string(name));
+    if (found != names_.end()) {
+      if (!std::holds_alternative<T>(snapshot_.read()->values[found->second])) {
+        throw std::runtime_error("config key '" + std::string(name) + "' has another type");
+      }
+      return ConfigKey<T>(found->second);
+    }
+
+    const auto entry = file_entries_.find(name);
+    value_type value = (entry != file_entries_.end()) ? value_type(parse<T>(name, entry->second))
+                                                      : value_type(std::move(default_value));
+
+    std::size_t index = 0;
+    snapshot_.update_deferred([&](Values& values) {
+      index = values.values.size();
+      values.values.push_back(std::move(value));
+    });
+    names_.emplace(std::string(name), index);
+    return ConfigKey<T>(index);
+  }
+
+  ConfigKey<std::string> key(std::string_view name, const char* default_value) {
+    return key<std::string>(name, std::string(default_value));
+  }
+
+  template <typename T>
+  [[nodiscard]] T get(ConfigKey<T> key) const {
+    return view().get(key);
+  }
+
+  [[nodiscard]] View view() const noexcept { return View(snapshot_); }
+
+  [[nodiscard]] auto version() const noexcept -> std::uint64_t { return view().version(); }
+
+  template <typename T>
+  void set(ConfigKey<T> key, T value) {
+    std::lock_guard lock{writer_mutex_};
+    std::uint64_t version = 0;
+    snapshot_.update_deferred([&](Values& values) {
+      values.values[key.index()] = std::move(value);
+      version = ++values.version;
+    });
+    changes_.publish(Change{key.index(), version});
+  }
+
+  /**
+   * Maps `path` and applies it to the interned keys, in a single snapshot.
+   * Keys not interned yet pick their value up when they are.
+   *
+   * @throw std::system_error if the file can't be mapped,
+   *        std::runtime_error if a value of an interned key doesn't parse (nothing is applied then).
+   */
+  void load_file(const std::string& path) {
+    detail::MappedConfigFile file{path};
+    auto entries = index_entries(file.text());
+
+    std::lock_guard lock{writer_mutex_};
+    const auto current = snapshot_.load();
+    std::vector<std::pair<std::size_t, value_type>> updates;
+    for (const auto& [name, index] : names_) {
+      const auto entry = entries.find(name);
+      if (entry == entries.end()) {
+        continue;
+      }
+      auto value = std::visit(
+        [&](const auto& old) -> value_type { return parse<std::decay_t<decltype(old)>>(name, entry->second); },
+        current->values[index]);
+      if (value != current->values[index]) {
+        updates.emplace_back(index, std::move(value));
+      }
+    }
+
+    file_ = std::move(file);
+    file_entries_ = std::move(entries);
+    if (updates.empty()) {
+      return;
+    }
+
+    std::uint64_t version = 0;
+    snapshot_.update_deferred([&](Values& values) {
+      for (auto& [index, value] : updates) {
+        values.values[index] = std::move(value);
+      }
+      version = ++values.version;
+    });
+    for (const auto& update : updates) {
+      changes_.publish(Change{update.first, version});
+    }
+  }
+
+  /// change notifications from now on.
+  subscription_type subscribe() { return changes_.subscribe(); }
+
+ private:
+  static auto trim(std::string_view text) noexcept -> std::string_view {
+    constexpr std::string_view spaces = " \t\r";
+    const auto first = text.find_first_not_of(spaces);
+    if (first == std::string_view::npos) {
+      return {};
+    }
+    return text.substr(first, text.find_last_not_of(spaces) - first + 1);
+  }
+
+  static auto index_entries(std::string_view text) -> std::unordered_map<std::string_view, std::string_view> {
+    std::unordered_map<std::string_view, std::string_view> entries;
+    while (!text.empty()) {
+      const auto end = text.find('\n');
+      auto line = text.substr(0, end);
+      text = (end == std::string_view::npos) ? std::string_view() : text.substr(end + 1);
+
+      line = line.substr(0, line.find('#'));
+      const auto separator = line.find('=');
+      if (separator == std::string_view::npos) {
+        continue;
+      }
+      const auto name = trim(line.substr(0, separator));
+      if (!name.empty()) {
+        entries[name] = trim(line.substr(separator + 1));
+      }
+    }
+    return entries;
+  }
+
+  template <typename T>
+  static T parse(std::string_view name, std::string_view text) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (text.size() >= 2 && text.front() == '"' && text.back() == '"') {
+        text = text.substr(1, text.size() - 2);
+      }
+      return std::string(text);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      if (text == "true" || text == "yes" || text == "on" || text == "1") return true;
+      if (text == "false" || text == "no" || text == "off" || text == "0") return false;
+    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+      std::int64_t value = 0;
+      const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+      if (error == std::errc() && end == text.data() + text.size()) return value;
+    } else {
+      const std::string copy(text);
+      char* end = nullptr;
+      const double value = std::strtod(copy.c_str(), &end);
+      if (!copy.empty() && end == copy.c_str() + copy.size()) return value;
+    }
+    throw std::runtime_error("config key '" + std::string(name) + "': bad value '" + std::string(text) + "'");
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_CONFIG_MANAGER_HPP_
@@ -0,0 +1,210 @@
+#ifndef TOYPP_EVENT_SYSTEM_HPP_
+#define TOYPP_EVENT_SYSTEM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "toypp/threaded/shared_spinmutex.hpp"
+#include "toypp/threaded/threadpool.hpp"
+#include "toypp/tmputils.hpp"
+
+namespace tpp {
+
+/// SharedLockable that doesn't lock anything.
+struct NoLock {
+  void lock() noexcept {}
+  bool try_lock() noexcept { return true; }
+  void unlock() noexcept {}
+  void lock_shared() noexcept {}
+  bool try_lock_shared() noexcept { return true; }
+  void unlock_shared() noexcept {}
+};
+
+/**
+ * Publish/subscribe of events whose types are all known at compile time.
+ *
+ * Event types are listed either directly (`EventSystem<Click, Key>`) or as a
+ * `type_pack` (`EventSystem<type_pack<Click, Key>>`), e.g. to share one list
+ * between several systems.
+ *
+ * Each event type gets its own handler table, found by its index in
+ * `Events...`: emitting is an array lookup followed by indirect calls through
+ * plain function pointers, no string keys, no `std::function`. Emitting an
+ * event type that isn't listed doesn't compile.
+ *
+ * Delivery is either synchronous (`emit`, in the calling thread) or queued
+ * (`post`, a task emitting it later on a `BasicThreadPool`, hooked or not).
+ *
+ * Handlers may run concurrently on several threads; they must not subscribe
+ * or unsubscribe from inside a handler.
+ *
+ * @tparam SharedMutex guards the handler tables; `NoLock` drops the locking
+ *  cost from `emit` when every subscription is made before emitting starts.
+ */
+template <typename SharedMutex, typename ...Events>
+class BasicEventSystem {
+  static_assert(sizeof...(Events) > 0, "at least one event type is needed.");
+  static_assert(pack_is_unique_v<Events...>, "event types must be unique.");
+
+ public:
+  using handler_id = std::uint64_t;
+
+  template <typename Event>
+  constexpr static std::size_t index_of = pack_index_of_v<std::remove_cv_t<Event>, Events...>;
+
+ private:
+  /// what a handler is called on: an object, or a free function (which can't round-trip through `void*`).
+  union Context {
+    void* object;
+    void (*function)();
+  };
+
+  struct Delegate {
+    void (*call)(Context context, const void* event);
+    Context context;
+    handler_id id;
+  };
+
+  std::array<std::vector<Delegate>, sizeof...(Events)> handlers_{};
+  mutable SharedMutex mutex_;
+  handler_id next_id_ = 1;
+  // the pool type is erased, so any `BasicThreadPool<Hooks>` fits.
+  void* pool_ = nullptr;
+  void (*add_task_)(void* pool, std::function<void()> task) = nullptr;
+
+ public:
+  BasicEventSystem() {}
+
+  /// `post` delivers on `pool`; the event system must outlive the events queued there.
+  template <bool Hooks>
+  explicit BasicEventSystem(BasicThreadPool<Hooks>& pool)
+    : pool_(&pool)
+    , add_task_([](void* pool, std::function<void()> task) {
+        static_cast<BasicThreadPool<Hooks>*>(pool)->add_task(std::move(task));
+      })
+  {}
+
+  BasicEventSystem(const BasicEventSystem&) = delete;
+  BasicEventSystem& operator=(const BasicEventSystem&) = delete;
+
+  /// subscribes a free function; a captureless lambda needs `Event` given explicitly (`subscribe<Click>(+lambda)`).
+  template <typename Event>
+  handler_id subscribe(void (*handler)(const Event&)) {
+    Context context;
+    context.function = reinterpret_cast<void (*)()>(handler);
+    return add<Event>(
+      [](Context context, const void* event) {
+        reinterpret_cast<void (*)(const Event&)>(context.function)(*static_cast<const Event*>(event));
+      },
+      context);
+  }
+
+  /// subscribes `object.*Method`; `object` must outlive the subscription.
+  template <typename Event, auto Method, typename C>
+  handler_id subscribe(C& object) {
+    return add<Event>(
+      [](Context context, const void* event) {
+        (static_cast<C*>(context.object)->*Method)(*static_cast<const Event*>(event));
+      },
+      object_context(object));
+  }
+
+  /// subscribes a callable (const or not) by reference; it must outlive the subscription.
+  template <typename Event, typename F>
+  handler_id subscribe(F& handler) {
+    static_assert(std::is_invocable_v<F&, const Event&>, "handler must accept the event.");
+    return add<Event>(
+      [](Context context, const void* event) {
+        (*static_cast<F*>(context.object))(*static_cast<const Event*>(event));
+      },
+      object_context(handler));
+  }
+
+  /// @return false if `id` isn't subscribed to `Event`.
+  template <typename Event>
+  bool unsubscribe(handler_id id) {
+    std::lock_guard lock{mutex_};
+    auto& handlers = std::get<index_of<Event>>(handlers_);
+    const auto found = std::find_if(handlers.begin(), handlers.end(),
+                                    [id](const Delegate& delegate) { return delegate.id == id; });
+    if (found == handlers.end()) {
+      return false;
+    }
+    handlers.erase(found);
+    return true;
+  }
+
+  template <typename Event>
+  [[nodiscard]] std::size_t handlers_count() const {
+    std::shared_lock lock{mutex_};
+    return std::get<index_of<Event>>(handlers_).size();
+  }
+
+  /// calls every handler of `Event`, in subscription order, in this thread.
+  template <typename Event>
+  void emit(const Event& event) const {
+    std::shared_lock lock{mutex_};
+    for (const auto& delegate : std::get<index_of<Event>>(handlers_)) {
+      delegate.call(delegate.context, &event);
+    }
+  }
+
+  /**
+   * Queues `event` to be emitted on the thread pool.
+   * Without a pool, it is emitted right away.
+   */
+  template <typename Event>
+  void post(Event event) {
+    using event_type = std::remove_cv_t<std::remove_reference_t<Event>>;
+    static_assert(std::is_copy_constructible_v<event_type>, "queued events are stored in a std::function.");
+
+    if (!pool_) {
+      emit<event_type>(event);
+      return;
+    }
+    add_task_(pool_, [this, event = std::move(event)] { emit<event_type>(event); });
+  }
+
+ private:
+  /// `T` may be const: the call thunk casts back to `T*` before using it.
+  template <typename T>
+  static Context object_context(T& object) noexcept {
+    Context context;
+    context.object = const_cast<void*>(static_cast<const void*>(std::addressof(object)));
+    return context;
+  }
+
+  template <typename Event>
+  handler_id add(void (*call)(Context, const void*), Context context) {
+    std::lock_guard lock{mutex_};
+    const auto id = next_id_++;
+    std::get<index_of<Event>>(handlers_).push_back(Delegate{call, context, id});
+    return id;
+  }
+};
+
+/// `BasicEventSystem<SharedMutex, type_pack<Events...>>` is `BasicEventSystem<SharedMutex, Events...>`.
+template <typename SharedMutex, typename ...Events>
+class BasicEventSystem<SharedMutex, type_pack<Events...>>
+  : public type_pack<Events...>::template rexpand_into<BasicEventSystem, SharedMutex> {
+  using base_type = typename type_pack<Events...>::template rexpand_into<BasicEventSystem, SharedMutex>;
+
+ public:
+  using base_type::base_type;
+};
+
+template <typename ...Events>
+using EventSystem = BasicEventSystem<SharedSpinMutex, Events...>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_EVENT_SYSTEM_HPP_
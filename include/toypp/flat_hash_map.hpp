@@ -0,0 +1,377 @@
+#ifndef TOYPP_FLAT_HASH_MAP_HPP_
+#define TOYPP_FLAT_HASH_MAP_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace tpp {
+
+/**
+ * @brief Open-addressing hash map with Robin Hood linear probing.
+ *
+ * Entries live in one contiguous slot array, next to a parallel array of
+ * one-byte probe distances (0 = empty slot). Inserting steals the slot of
+ * any entry closer to its home than the new one, so a lookup can stop as
+ * soon as it meets an entry richer than the probe; removing shifts the
+ * following cluster back instead of leaving tombstones.
+ *
+ * Lookups take any `K` when both `Hash` and `KeyEqual` are transparent.
+ * Stored probe distances (1 = home slot) are capped at 254: an insertion that
+ * would go further grows the table, or throws `std::length_error` if the table
+ * is mostly empty (the hash is broken), leaving the map unchanged.
+ * Growing (or removing) moves entries, invalidating pointers and iterators.
+ */
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+ private:
+  union Slot {
+    value_type value;
+
+    Slot() noexcept {}
+    ~Slot() {}
+  };
+
+  static constexpr std::size_t k_npos = ~std::size_t{0};
+  static constexpr std::size_t k_min_capacity = 16;
+  /// the longest stored probe distance.
+  static constexpr std::uint8_t k_max_distance = 254;
+
+  template <typename H, typename = void>
+  struct has_is_transparent : std::false_type {};
+
+  template <typename H>
+  struct has_is_transparent<H, std::void_t<typename H::is_transparent>> : std::true_type {};
+
+  template <typename K>
+  using enable_heterogeneous_t = std::enable_if_t<has_is_transparent<Hash>::value
+                                               && has_is_transparent<KeyEqual>::value
+                                               && !std::is_same_v<std::decay_t<K>, Key>, int>;
+
+  std::unique_ptr<Slot[]> slots_;
+  std::unique_ptr<std::uint8_t[]> distances_;
+  std::size_t capacity_ = 0;
+  std::size_t size_ = 0;
+  std::size_t mask_ = 0;
+  unsigned shift_ = 64;
+
+ public:
+  /// forward iterator over the entries, in slot order.
+  class const_iterator {
+    friend class FlatHashMap;
+
+    const FlatHashMap* owner_ = nullptr;
+    std::size_t index_ = 0;
+
+    const_iterator(const FlatHashMap* owner, std::size_t index) noexcept
+      : owner_(owner), index_(index)
+    {
+      skip_empty();
+    }
+
+    void skip_empty() noexcept {
+      while (index_ < owner_->capacity_ && owner_->distances_[index_] == 0) {
+        ++index_;
+      }
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename FlatHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() noexcept = default;
+
+    reference operator*() const noexcept { return owner_->slots_[index_].value; }
+    pointer operator->() const noexcept { return std::addressof(**this); }
+
+    const_iterator& operator++() noexcept {
+      ++index_;
+      skip_empty();
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+  };
+
+  FlatHashMap() noexcept {}
+
+  FlatHashMap(const FlatHashMap& other) {
+    if (other.empty()) return;
+    reserve(other.size_);
+    try {
+      for (const auto& entry : other) {
+        place(value_type(entry));
+      }
+    } catch (...) {
+      destroy_all();
+      throw;
+    }
+  }
+
+  FlatHashMap(FlatHashMap&& other) noexcept
+    : slots_(std::move(other.slots_))
+    , distances_(std::move(other.distances_))
+    , capacity_(std::exchange(other.capacity_, 0))
+    , size_(std::exchange(other.size_, 0))
+    , mask_(std::exchange(other.mask_, 0))
+    , shift_(std::exchange(other.shift_, 64))
+  {}
+
+  FlatHashMap& operator=(FlatHashMap other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~FlatHashMap() { destroy_all(); }
+
+  void swap(FlatHashMap& other) noexcept {
+    std::swap(slots_, other.slots_);
+    std::swap(distances_, other.distances_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(mask_, other.mask_);
+    std::swap(shift_, other.shift_);
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  [[nodiscard]] auto load_factor() const noexcept -> double {
+    return capacity_ == 0 ? 0.0 : static_cast<double>(size_) / static_cast<double>(capacity_);
+  }
+
+  /// makes room for `n` entries without growing.
+  void reserve(std::size_t n) {
+    std::size_t capacity = k_min_capacity;
+    while (max_size_for(capacity) < n) {
+      capacity <<= 1;
+    }
+    if (capacity > capacity_) {
+      rehash(capacity);
+    }
+  }
+
+  void clear() noexcept {
+    destroy_all();
+    size_ = 0;
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return const_iterator(this, 0); }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return const_iterator(this, capacity_); }
+
+  Value* at(const Key& key) noexcept { return value_at(find_index(key)); }
+  const Value* at(const Key& key) const noexcept { return value_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  Value* at(const K& key) noexcept { return value_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  const Value* at(const K& key) const noexcept { return value_at(find_index(key)); }
+
+  bool contains(const Key& key) const noexcept { return find_index(key) != k_npos; }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  bool contains(const K& key) const noexcept { return find_index(key) != k_npos; }
+
+  /// @return false if `key` is already there and `can_override` is not set.
+  bool insert(Key key, Value value, bool can_override = false) {
+    const auto index = find_index(key);
+    if (index != k_npos) {
+      if (!can_override) return false;
+      slots_[index].value.second = std::move(value);
+      return true;
+    }
+
+    make_room_for(key);
+    place(value_type(std::move(key), std::move(value)));
+    return true;
+  }
+
+  bool insert_or_assign(Key key, Value value) {
+    return insert(std::move(key), std::move(value), true);
+  }
+
+  bool remove(const Key& key) { return remove_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  bool remove(const K& key) { return remove_at(find_index(key)); }
+
+  Value& operator[](const Key& key) {
+    auto index = find_index(key);
+    if (index == k_npos) {
+      make_room_for(key);
+      index = place(value_type(key, Value{}));
+      if (index == k_npos) {
+        index = find_index(key);
+      }
+    }
+    return slots_[index].value.second;
+  }
+
+ private:
+  static constexpr auto max_size_for(std::size_t capacity) noexcept -> std::size_t {
+    return capacity - capacity / 8;
+  }
+
+  /// fibonacci hashing: spreads weak hashes (e.g. identity for integers) over the top bits.
+  template <typename K>
+  auto home_of(const K& key) const noexcept -> std::size_t {
+    const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+    return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> shift_);
+  }
+
+  template <typename K>
+  auto find_index(const K& key) const noexcept -> std::size_t {
+    if (size_ == 0) return k_npos;
+
+    auto index = home_of(key);
+    for (std::uint8_t distance = 1;; ++distance) {
+      const auto current = distances_[index];
+      if (current < distance) return k_npos;
+      if (current == distance && KeyEqual{}(slots_[index].value.first, key)) return index;
+      index = (index + 1) & mask_;
+    }
+  }
+
+  auto value_at(std::size_t index) const noexcept -> Value* {
+    return index == k_npos ? nullptr : std::addressof(slots_[index].value.second);
+  }
+
+  /// grows until `key` can be placed without overflowing a probe distance.
+  void make_room_for(const Key& key) {
+    if (size_ + 1 > max_size_for(capacity_)) {
+      rehash(capacity_ == 0 ? k_min_capacity : capacity_ * 2);
+    }
+
+    while (longest_distance_after_insert(home_of(key)) > k_max_distance) {
+      if (size_ < capacity_ / 8) {
+        throw std::length_error("tpp::FlatHashMap: too many collisions");
+      }
+      rehash(capacity_ * 2);
+    }
+  }
+
+  /// dry run of `place`: the longest probe distance an insertion from `index` would store.
+  auto longest_distance_after_insert(std::size_t index) const noexcept -> std::size_t {
+    std::size_t longest = 1;
+    for (std::size_t distance = 1; distances_[index] != 0; index = (index + 1) & mask_) {
+      distance = std::min<std::size_t>(distance, distances_[index]) + 1;
+      longest = std::max(longest, distance);
+    }
+    return longest;
+  }
+
+  /**
+   * Robin Hood insertion of a key known to be absent.
+   *
+   * @return where `entry` landed, or npos if the table had to grow meanwhile.
+   */
+  auto place(value_type entry) -> std::size_t {
+    auto index = home_of(entry.first);
+    auto placed = k_npos;
+
+    for (std::uint8_t distance = 1;; index = (index + 1) & mask_) {
+      auto& current = distances_[index];
+      if (current == 0) {
+        ::new (std::addressof(slots_[index].value)) value_type(std::move(entry));
+        current = distance;
+        ++size_;
+        return placed == k_npos ? index : placed;
+      }
+
+      if (current < distance) {
+        using std::swap;
+        swap(entry, slots_[index].value);
+        swap(distance, current);
+        if (placed == k_npos) placed = index;
+      }
+
+      if (++distance > k_max_distance) {
+        // only reachable while rehashing: grow, then finish placing the evicted entry.
+        rehash(capacity_ * 2);
+        const auto landed = place(std::move(entry));
+        return placed == k_npos ? landed : k_npos;
+      }
+    }
+  }
+
+  bool remove_at(std::size_t index) {
+    if (index == k_npos) return false;
+
+    // backward shift: pull the rest of the cluster one slot closer to home.
+    for (auto next = (index + 1) & mask_; distances_[next] > 1; next = (next + 1) & mask_) {
+      slots_[index].value = std::move(slots_[next].value);
+      distances_[index] = static_cast<std::uint8_t>(distances_[next] - 1);
+      index = next;
+    }
+
+    slots_[index].value.~value_type();
+    distances_[index] = 0;
+    --size_;
+    return true;
+  }
+
+  void rehash(std::size_t capacity) {
+    auto old_slots = std::exchange(slots_, std::make_unique<Slot[]>(capacity));
+    auto old_distances = std::exchange(distances_, std::make_unique<std::uint8_t[]>(capacity));
+    const auto old_capacity = std::exchange(capacity_, capacity);
+
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (auto n = capacity; n > 1; n >>= 1) {
+      --shift_;
+    }
+    size_ = 0;
+
+    for (std::size_t index = 0; index < old_capacity; ++index) {
+      if (old_distances[index] != 0) {
+        place(std::move(old_slots[index].value));
+        old_slots[index].value.~value_type();
+      }
+    }
+  }
+
+  void destroy_all() noexcept {
+    for (std::size_t index = 0; index < capacity_; ++index) {
+      if (distances_[index] != 0) {
+        slots_[index].value.~value_type();
+        distances_[index] = 0;
+      }
+    }
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_FLAT_HASH_MAP_HPP_
@@ -4,6 +4,7 @@
 #include <iterator>
 #include <type_traits>
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,14 @@
 
 namespace tpp {
 
+/// `FlatMap` constructor tag: the pairs come in any order, possibly with duplicate keys.
+struct from_unsorted_t { explicit from_unsorted_t() = default; };
+inline constexpr from_unsorted_t from_unsorted{};
+
+/// `FlatMap` constructor tag: the container is already sorted by key, without duplicates (not checked).
+struct sorted_unique_t { explicit sorted_unique_t() = default; };
+inline constexpr sorted_unique_t sorted_unique{};
+
 template <typename Key,
           typename Value,
           typename Compare = std::less<Key>,
@@ -30,8 +39,45 @@ class FlatMap {
 
   constexpr FlatMap() noexcept {}
 
+  /// sorts and dedups once, O(n log n); the first of equal keys wins, like repeated `insert`.
+  template <typename Range>
+  constexpr FlatMap(from_unsorted_t, Range&& range) {
+    append(std::forward<Range>(range));
+    container_.erase(sort_unique(std::begin(container_), std::end(container_)), std::end(container_));
+  }
+
+  /// adopts `container` as is.
+  constexpr FlatMap(sorted_unique_t, Container container) : container_(std::move(container)) {}
+
   constexpr void reserve(std::size_t n) { container_.reserve(n); }
 
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return std::size(container_); }
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return std::empty(container_); }
+
+  constexpr auto begin() const noexcept { return std::begin(container_); }
+  constexpr auto end() const noexcept { return std::end(container_); }
+
+  /**
+   * Inserts many pairs at once: appends them, sorts the tail and merges it in place,
+   * O(m log m + n) instead of O(m * n). Existing keys win, then the first of equal new keys.
+   *
+   * @return how many keys were added.
+   */
+  template <typename Range>
+  constexpr std::size_t insert_bulk(Range&& range) {
+    const auto old_size = std::size(container_);
+    append(std::forward<Range>(range));
+
+    const auto middle = std::begin(container_) + old_size;
+    container_.erase(sort_unique(middle, std::end(container_)), std::end(container_));
+    std::inplace_merge(std::begin(container_), std::begin(container_) + old_size, std::end(container_), KeyLess{});
+
+    // stable merge: an existing key comes first among equals, so it is the one kept.
+    container_.erase(std::unique(std::begin(container_), std::end(container_), KeyEquivalent{}),
+                     std::end(container_));
+    return std::size(container_) - old_size;
+  }
+
   constexpr Value* at(const Key& key) noexcept {
     const auto res = binary_search(container_, key);
     if (!res.found) return nullptr;
@@ -52,13 +98,7 @@ class FlatMap {
       return true;
     }
 
-    container_.emplace_back(std::move(key), std::move(value));
-
-    // rotate to the right by 1.
-    std::rotate(std::begin(container_) + res.index,
-                std::begin(container_) + (std::size(container_) - 1),
-                std::end(container_));
-
+    container_.emplace(std::begin(container_) + res.index, std::move(key), std::move(value));
     return true;
   }
 
@@ -70,13 +110,7 @@ class FlatMap {
     const auto res = binary_search(container_, key);
     if (!res.found) return false;
 
-    // rotate to the left by 1.
-    std::rotate(std::begin(container_) + res.index,
-                std::begin(container_) + res.index + 1,
-                std::end(container_));
-
-    container_.pop_back();
-
+    container_.erase(std::begin(container_) + res.index);
     return true;
   }
 
@@ -93,30 +127,55 @@ class FlatMap {
   }
 
  private:
+  /// compares entries by key; generic so that proxy references (see `SoAContainer`) aren't converted.
+  struct KeyLess {
+    template <typename L, typename R>
+    constexpr bool operator()(const L& lhs, const R& rhs) const { return Compare{}(lhs.first, rhs.first); }
+  };
+
+  struct KeyEquivalent {
+    template <typename L, typename R>
+    constexpr bool operator()(const L& lhs, const R& rhs) const {
+      return !KeyLess{}(lhs, rhs) && !KeyLess{}(rhs, lhs);
+    }
+  };
+
+  template <typename Range>
+  constexpr void append(Range&& range) {
+    if constexpr (std::is_rvalue_reference_v<Range&&>) {
+      container_.insert(std::end(container_),
+                        std::make_move_iterator(std::begin(range)),
+                        std::make_move_iterator(std::end(range)));
+    } else {
+      container_.insert(std::end(container_), std::begin(range), std::end(range));
+    }
+  }
+
+  /// @return the new end of `[first, last)`, sorted with the first of equal keys kept.
+  template <typename It>
+  static constexpr It sort_unique(It first, It last) {
+    std::stable_sort(first, last, KeyLess{});
+    return std::unique(first, last, KeyEquivalent{});
+  }
+
+  /// lower bound: `index` is where `value` is, or where it would be inserted.
   template <typename C, typename T>
   static constexpr SearchResult binary_search(C&& container, T&& value)
   {
-    if (std::size(container) == 0) return {};
-
     Compare compare{};
 
-    // due unsigned overflow problem when calculating `mid`...
-    if (compare(value, container[0].first)) return {false, 0};
-
     std::size_t low = 0;
-    std::size_t high = std::size(container) - 1;
-
-    std::size_t mid = 0;  
-    while (low <= high) {
-      mid = low + (high - low) / 2;
-
-      if (value == container[mid].first) return {true, mid};
+    std::size_t high = std::size(container);
+    while (low < high) {
+      const auto mid = low + (high - low) / 2;
 
       if (compare(container[mid].first, value)) low  = mid + 1;
-      else                                      high = mid - 1;
+      else                                      high = mid;
     }
-  
-    return {false, mid};
+
+    // equivalence through `Compare` only, `==` may disagree with it.
+    const bool found = low < std::size(container) && !compare(value, container[low].first);
+    return {found, low};
   }
 };
 
@@ -0,0 +1,121 @@
+#ifndef TOYPP_FROZEN_FLATMAP_HPP_
+#define TOYPP_FROZEN_FLATMAP_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "toypp/flatmap.hpp"
+
+namespace tpp {
+
+/**
+ * @brief Read-only `FlatMap` laid out for lookups.
+ *
+ * Keys are stored in Eytzinger (BFS) order: node `k` has its children at
+ * `2k` and `2k + 1`, so the first levels of the implicit tree share a few
+ * cache lines, and the descent is branchless (`k = 2k + less`) with the
+ * node four levels down prefetched. Values sit in a parallel array, so
+ * the key array stays dense and a lookup touches one value at most.
+ *
+ * Built once from a `FlatMap` or from unsorted pairs; no insertion.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FrozenFlatMap {
+  /// the 16 descendants 4 levels below node `k` are contiguous, from `16k`.
+  static constexpr std::size_t k_prefetch_levels = 4;
+
+  std::vector<Key> keys_{};
+  std::vector<Value> values_{};
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  FrozenFlatMap() noexcept {}
+
+  template <typename Container>
+  explicit FrozenFlatMap(const FlatMap<Key, Value, Compare, Container>& map) {
+    const auto size = map.size();
+    keys_.reserve(size);
+    values_.reserve(size);
+
+    // node `k` (1-based) receives the sorted entry `order[k - 1]`.
+    std::vector<std::size_t> order(size);
+    std::size_t next = 0;
+    assign_in_order(order, 1, next);
+
+    const auto sorted = map.begin();
+    for (const auto index : order) {
+      const auto& entry = sorted[static_cast<std::ptrdiff_t>(index)];
+      keys_.push_back(entry.first);
+      values_.push_back(entry.second);
+    }
+  }
+
+  /// see `FlatMap(from_unsorted, range)`.
+  template <typename Range>
+  FrozenFlatMap(from_unsorted_t tag, Range&& range)
+    : FrozenFlatMap(FlatMap<Key, Value, Compare>(tag, std::forward<Range>(range)))
+  {}
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return keys_.size(); }
+  [[nodiscard]] auto empty() const noexcept -> bool { return keys_.empty(); }
+
+  const Value* at(const Key& key) const noexcept {
+    const auto node = lower_bound(key);
+    if (node == 0 || Compare{}(key, keys_[node - 1])) return nullptr;
+    return std::addressof(values_[node - 1]);
+  }
+
+  bool contains(const Key& key) const noexcept { return at(key) != nullptr; }
+
+ private:
+  /// in-order walk of the implicit tree, handing out sorted positions.
+  void assign_in_order(std::vector<std::size_t>& order, std::size_t node, std::size_t& next) const {
+    if (node > order.size()) return;
+    assign_in_order(order, 2 * node, next);
+    order[node - 1] = next++;
+    assign_in_order(order, 2 * node + 1, next);
+  }
+
+  /// @return the 1-based node of the first key not less than `key`, 0 if none.
+  std::size_t lower_bound(const Key& key) const noexcept {
+    const auto size = keys_.size();
+    const Key* keys = keys_.data();
+    Compare compare{};
+
+    std::size_t node = 1;
+    while (node <= size) {
+#if defined(__GNUC__) || defined(__clang__)
+      const auto ahead = node << k_prefetch_levels;
+      if (ahead <= size) {
+        __builtin_prefetch(keys + ahead - 1);
+      }
+#endif
+      node = 2 * node + static_cast<std::size_t>(compare(keys[node - 1], key));
+    }
+
+    // the path went right (1 bits) past the answer, then left once more than needed:
+    // drop the trailing 1s and that last 0.
+    return node >> trailing_ones_plus_one(node);
+  }
+
+  static constexpr unsigned trailing_ones_plus_one(std::size_t node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(node))) + 1;
+#else
+    unsigned count = 1;
+    for (; node & 1; node >>= 1) {
+      ++count;
+    }
+    return count;
+#endif
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_FROZEN_FLATMAP_HPP_
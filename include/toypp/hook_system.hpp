@@ -0,0 +1,177 @@
+#ifndef TOYPP_HOOK_SYSTEM_HPP_
+#define TOYPP_HOOK_SYSTEM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "toypp/sharedptr.hpp"
+#include "toypp/threaded/atomic_snapshot.hpp"
+#include "toypp/tmputils.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TOYPP_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define TOYPP_NOINLINE __declspec(noinline)
+#else
+#define TOYPP_NOINLINE
+#endif
+
+namespace tpp {
+
+/**
+ * Instrumentation point: calling it runs every registered handler with `Args...`.
+ *
+ * Meant for hot paths. With no handler registered, a call is one relaxed
+ * load of a flag; with `Enabled == false`, the hook is an empty type and calls
+ * compile to nothing. Handlers are kept in an immutable array, swapped as a
+ * whole on add/remove (`AtomicSnapshot`), so calling never takes a lock.
+ *
+ * Adding and removing handlers is slow (it waits for in-flight calls), and
+ * must not be done from inside a handler.
+ *
+ * @tparam Enabled false compiles the hook out.
+ * @tparam Args what the call site passes to the handlers.
+ */
+template <bool Enabled, typename ...Args>
+class BasicHook;
+
+template <typename ...Args>
+class BasicHook<false, Args...> {
+ public:
+  using handler_id = std::uint64_t;
+
+  static constexpr bool enabled = false;
+
+  template <typename ...Ts>
+  void operator()(Ts&&...) const noexcept {}
+
+  [[nodiscard]] bool active() const noexcept { return false; }
+};
+
+template <typename ...Args>
+class BasicHook<true, Args...> {
+ public:
+  using handler_id = std::uint64_t;
+
+  static constexpr bool enabled = true;
+
+ private:
+  struct Handler {
+    void (*call)(void* context, Args... args);
+    void* context;
+    handler_id id;
+  };
+
+  using handlers_type = std::vector<Handler>;
+
+  std::atomic<bool> active_{false};
+  mutable AtomicSnapshot<handlers_type> handlers_{tpp::make_shared<handlers_type>()};
+  std::atomic<handler_id> next_id_{1};
+
+ public:
+  BasicHook() {}
+  BasicHook(const BasicHook&) = delete;
+  BasicHook& operator=(const BasicHook&) = delete;
+
+  void operator()(Args... args) const {
+    if (!active_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    call_handlers(args...);
+  }
+
+  [[nodiscard]] bool active() const noexcept { return active_.load(std::memory_order_relaxed); }
+
+  /// adds a free function (or a captureless lambda).
+  handler_id add(void (*handler)(Args...)) {
+    return add_handler(
+      [](void* context, Args... args) { reinterpret_cast<void (*)(Args...)>(context)(args...); },
+      reinterpret_cast<void*>(handler));
+  }
+
+  /// adds `object.*Method`; `object` must outlive the registration.
+  template <auto Method, typename C>
+  handler_id add(C& object) {
+    return add_handler(
+      [](void* context, Args... args) { (static_cast<C*>(context)->*Method)(args...); },
+      &object);
+  }
+
+  /// adds a callable by reference; it must outlive the registration.
+  template <typename F, typename = std::enable_if_t<std::is_invocable_v<F&, Args...>>>
+  handler_id add(F& handler) {
+    return add_handler(
+      [](void* context, Args... args) { (*static_cast<F*>(context))(args...); },
+      &handler);
+  }
+
+  /// @return false if `id` isn't registered.
+  bool remove(handler_id id) {
+    bool removed = false;
+    handlers_.update([&](handlers_type& handlers) {
+      const auto found = std::find_if(handlers.begin(), handlers.end(),
+                                      [id](const Handler& handler) { return handler.id == id; });
+      if (found != handlers.end()) {
+        handlers.erase(found);
+        removed = true;
+      }
+      active_.store(!handlers.empty(), std::memory_order_relaxed);
+    });
+    return removed;
+  }
+
+ private:
+  handler_id add_handler(void (*call)(void*, Args...), void* context) {
+    const auto id = next_id_.fetch_add(1, std::memory_order_relaxed);
+    handlers_.update([&](handlers_type& handlers) { handlers.push_back(Handler{call, context, id}); });
+    active_.store(true, std::memory_order_relaxed);
+    return id;
+  }
+
+  // kept out of line, so the disabled check stays small at the call sites.
+  TOYPP_NOINLINE void call_handlers(Args... args) const {
+    const auto handlers = handlers_.read();
+    for (const auto& handler : *handlers) {
+      handler.call(handler.context, args...);
+    }
+  }
+};
+
+template <typename ...Args>
+using Hook = BasicHook<true, Args...>;
+
+/**
+ * A set of hooks looked up by tag type at compile time.
+ *
+ * Each tag names its hook type: `struct OnSave { using hook_type = tpp::Hook<const Doc&>; };`.
+ */
+template <typename ...Tags>
+class HookSystem {
+  static_assert(pack_is_unique_v<Tags...>, "hook tags must be unique.");
+
+  std::tuple<typename Tags::hook_type...> hooks_;
+
+ public:
+  HookSystem() {}
+  HookSystem(const HookSystem&) = delete;
+  HookSystem& operator=(const HookSystem&) = delete;
+
+  template <typename Tag>
+  auto& hook() noexcept { return std::get<pack_index_of_v<Tag, Tags...>>(hooks_); }
+
+  template <typename Tag>
+  const auto& hook() const noexcept { return std::get<pack_index_of_v<Tag, Tags...>>(hooks_); }
+
+  template <typename Tag, typename ...Ts>
+  void call(Ts&&... args) const { hook<Tag>()(std::forward<Ts>(args)...); }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_HOOK_SYSTEM_HPP_
@@ -0,0 +1,236 @@
+#ifndef TOYPP_PERFECT_HASH_MAP_HPP_
+#define TOYPP_PERFECT_HASH_MAP_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace tpp {
+
+namespace detail {
+
+/// splitmix64 finalizer.
+constexpr auto mix64(std::uint64_t value) noexcept -> std::uint64_t {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ull;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBull;
+  value ^= value >> 31;
+  return value;
+}
+
+}  // namespace detail
+
+/**
+ * Seeded `constexpr` hash for `PerfectHashMap`: 8 bytes per step for
+ * `std::string_view` (assembled byte by byte, which compilers fold into a
+ * load), splitmix64 for integers and enums.
+ */
+template <typename Key, typename = void>
+struct PerfectHash;
+
+template <>
+struct PerfectHash<std::string_view> {
+  constexpr auto operator()(std::string_view key, std::uint64_t seed) const noexcept -> std::uint64_t {
+    std::uint64_t hash = seed ^ (key.size() * 0x9E3779B97F4A7C15ull);
+    std::size_t index = 0;
+    for (; index + 8 <= key.size(); index += 8) {
+      hash = step(hash, load(key, index, 8));
+    }
+    if (index < key.size()) {
+      hash = step(hash, load(key, index, key.size() - index));
+    }
+    return hash;
+  }
+
+ private:
+  static constexpr auto load(std::string_view key, std::size_t index, std::size_t count) noexcept -> std::uint64_t {
+    std::uint64_t word = 0;
+    for (std::size_t byte = 0; byte < count; ++byte) {
+      word |= std::uint64_t{static_cast<unsigned char>(key[index + byte])} << (8 * byte);
+    }
+    return word;
+  }
+
+  static constexpr auto step(std::uint64_t hash, std::uint64_t word) noexcept -> std::uint64_t {
+    hash = (hash ^ word) * 0xFF51AFD7ED558CCDull;
+    return hash ^ (hash >> 32);
+  }
+};
+
+template <typename Key>
+struct PerfectHash<Key, std::enable_if_t<std::is_integral_v<Key> || std::is_enum_v<Key>>> {
+  constexpr auto operator()(Key key, std::uint64_t seed) const noexcept -> std::uint64_t {
+    return detail::mix64(static_cast<std::uint64_t>(key) ^ seed);
+  }
+};
+
+/**
+ * @brief Immutable map over a key set known up front, with a minimal perfect hash (CHD).
+ *
+ * The constructor is `constexpr`: from a `constexpr` variable, the hash
+ * displacements and both tables are computed by the compiler, and nothing
+ * runs at startup. Keys hash to one of `N` buckets; each bucket holds the
+ * displacement that sends all its keys to distinct slots among `N`
+ * (a single-key bucket holds its slot directly). A lookup is one key hash,
+ * a modulo for the bucket, at most one integer mix for the slot (none for a
+ * single-key bucket) and one key compare.
+ *
+ * Meant for small, fixed key sets: `N` is capped at 4096. Building keeps
+ * about 50 bytes per key of scratch arrays on the stack (some 200KB at the
+ * cap), and checks for duplicates in O(N^2).
+ *
+ * Building throws `std::logic_error` on duplicate keys (a compile error in
+ * a constant expression).
+ */
+template <typename Key, typename Value, std::size_t N, typename Hash = PerfectHash<Key>>
+class PerfectHashMap {
+  static_assert(N > 0, "an empty key set needs no map.");
+  static_assert(N <= 4096, "building keeps O(N) scratch arrays on the stack, see the class doc.");
+
+  static constexpr std::uint32_t k_direct = std::uint32_t{1} << 31;
+  static constexpr std::uint32_t k_max_displacement = 1 << 16;
+  static constexpr std::uint64_t k_max_seeds = 64;
+
+  std::array<Key, N> keys_{};
+  std::array<Value, N> values_{};
+  std::array<std::uint32_t, N> displacements_{};
+  std::uint64_t seed_ = 0;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+  constexpr explicit PerfectHashMap(const std::array<value_type, N>& entries) { build(entries.data()); }
+  constexpr explicit PerfectHashMap(const value_type (&entries)[N]) { build(entries); }
+
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t { return N; }
+
+  constexpr const Value* at(const Key& key) const noexcept {
+    const auto hash = Hash{}(key, seed_);
+    const auto slot = slot_of(hash, displacements_[bucket_of(hash)]);
+    return keys_[slot] == key ? &values_[slot] : nullptr;
+  }
+
+  constexpr bool contains(const Key& key) const noexcept { return at(key) != nullptr; }
+
+  /// keys in slot order (no particular order).
+  [[nodiscard]] constexpr auto keys() const noexcept -> const std::array<Key, N>& { return keys_; }
+
+ private:
+  static constexpr auto bucket_of(std::uint64_t hash) noexcept -> std::size_t {
+    return static_cast<std::size_t>(hash % N);
+  }
+
+  static constexpr auto slot_of(std::uint64_t hash, std::uint32_t displacement) noexcept -> std::size_t {
+    if (displacement & k_direct) {
+      return displacement & ~k_direct;
+    }
+    return static_cast<std::size_t>(detail::mix64(hash ^ (displacement * 0x9E3779B97F4A7C15ull)) % N);
+  }
+
+  constexpr void build(const value_type* entries) {
+    for (std::size_t i = 0; i < N; ++i) {
+      for (std::size_t j = i + 1; j < N; ++j) {
+        if (entries[i].first == entries[j].first) {
+          throw std::logic_error("tpp::PerfectHashMap: duplicate key");
+        }
+      }
+    }
+
+    for (std::uint64_t seed = 0; seed < k_max_seeds; ++seed) {
+      if (try_build(entries, detail::mix64(seed + 1))) {
+        return;
+      }
+    }
+    throw std::logic_error("tpp::PerfectHashMap: no perfect hash found");
+  }
+
+  constexpr bool try_build(const value_type* entries, std::uint64_t seed) {
+    std::array<std::uint64_t, N> hashes{};
+    std::array<std::size_t, N + 1> starts{};
+    std::array<std::size_t, N> members{};
+    std::array<std::size_t, N> slot_owner{};
+    std::array<bool, N> taken{};
+    std::array<std::size_t, N> slots{};
+
+    // counting sort of the entries by bucket.
+    for (std::size_t i = 0; i < N; ++i) {
+      hashes[i] = Hash{}(entries[i].first, seed);
+      ++starts[bucket_of(hashes[i]) + 1];
+    }
+    std::size_t largest = 0;
+    for (std::size_t bucket = 0; bucket < N; ++bucket) {
+      largest = largest < starts[bucket + 1] ? starts[bucket + 1] : largest;
+      starts[bucket + 1] += starts[bucket];
+    }
+    {
+      std::array<std::size_t, N> fill{};
+      for (std::size_t i = 0; i < N; ++i) {
+        const auto bucket = bucket_of(hashes[i]);
+        members[starts[bucket] + fill[bucket]++] = i;
+      }
+    }
+
+    // largest buckets first, while most slots are free.
+    std::size_t next_free = 0;
+    for (auto size = largest; size > 0; --size) {
+      for (std::size_t bucket = 0; bucket < N; ++bucket) {
+        if (starts[bucket + 1] - starts[bucket] != size) continue;
+        const auto* bucket_members = &members[starts[bucket]];
+
+        if (size == 1) {
+          while (taken[next_free]) ++next_free;
+          displacements_[bucket] = k_direct | static_cast<std::uint32_t>(next_free);
+          taken[next_free] = true;
+          slot_owner[next_free] = bucket_members[0];
+          continue;
+        }
+
+        bool placed = false;
+        for (std::uint32_t displacement = 0; displacement < k_max_displacement && !placed; ++displacement) {
+          placed = true;
+          for (std::size_t k = 0; k < size && placed; ++k) {
+            slots[k] = slot_of(hashes[bucket_members[k]], displacement);
+            placed = !taken[slots[k]];
+            for (std::size_t other = 0; other < k && placed; ++other) {
+              placed = slots[other] != slots[k];
+            }
+          }
+          if (placed) {
+            displacements_[bucket] = displacement;
+            for (std::size_t k = 0; k < size; ++k) {
+              taken[slots[k]] = true;
+              slot_owner[slots[k]] = bucket_members[k];
+            }
+          }
+        }
+        if (!placed) return false;
+      }
+    }
+
+    for (std::size_t slot = 0; slot < N; ++slot) {
+      keys_[slot] = entries[slot_owner[slot]].first;
+      values_[slot] = entries[slot_owner[slot]].second;
+    }
+    seed_ = seed;
+    return true;
+  }
+};
+
+/**
+ * `constexpr auto map = make_perfect_hash_map<std::string_view, int>({{"GET", 1}, {"PUT", 2}});`
+ */
+template <typename Key, typename Value, std::size_t N>
+constexpr auto make_perfect_hash_map(const std::pair<Key, Value> (&entries)[N]) -> PerfectHashMap<Key, Value, N> {
+  return PerfectHashMap<Key, Value, N>(entries);
+}
+
+}  // namespace tpp
+
+#endif  // TOYPP_PERFECT_HASH_MAP_HPP_
@@ -0,0 +1,242 @@
+#ifndef TOYPP_SOA_CONTAINER_HPP_
+#define TOYPP_SOA_CONTAINER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "toypp/flatmap.hpp"
+
+namespace tpp {
+
+/**
+ * Reference to one element of a `SoAContainer`: a pair of references
+ * standing for the `std::pair<Key, Value>` spread over both arrays.
+ *
+ * Assigning through it (or converting it) copies, since a proxy can't tell
+ * a moved-from element from a plain dereference; `swap` exchanges in place.
+ */
+template <typename Key, typename Value>
+struct SoAReference {
+  using value_type = std::pair<std::remove_const_t<Key>, std::remove_const_t<Value>>;
+
+  Key& first;
+  Value& second;
+
+  SoAReference(Key& key, Value& value) noexcept : first(key), second(value) {}
+  SoAReference(const SoAReference&) noexcept = default;
+
+  /// from a mutable reference to a const one.
+  template <typename K, typename V,
+            typename = std::enable_if_t<std::is_convertible_v<K&, Key&> && std::is_convertible_v<V&, Value&>>>
+  SoAReference(const SoAReference<K, V>& other) noexcept : first(other.first), second(other.second) {}
+
+  operator value_type() const { return value_type(first, second); }
+
+  SoAReference& operator=(const SoAReference& other) {
+    first = other.first;
+    second = other.second;
+    return *this;
+  }
+
+  SoAReference& operator=(const value_type& entry) {
+    first = entry.first;
+    second = entry.second;
+    return *this;
+  }
+
+  SoAReference& operator=(value_type&& entry) {
+    first = std::move(entry.first);
+    second = std::move(entry.second);
+    return *this;
+  }
+
+  friend void swap(SoAReference lhs, SoAReference rhs) {
+    using std::swap;
+    swap(lhs.first, rhs.first);
+    swap(lhs.second, rhs.second);
+  }
+};
+
+/**
+ * @brief Structure-of-arrays sequence of `std::pair<Key, Value>`.
+ *
+ * Keys and values live in two containers, so a search walks a dense key
+ * array and only touches the value it lands on. Meant as the `Container`
+ * of `FlatMap` (see `SoAFlatMap`): it has the vector operations `FlatMap`
+ * uses, and random-access iterators whose `operator*` returns a proxy
+ * (`SoAReference`) with `first` and `second` members.
+ */
+template <typename Key,
+          typename Value,
+          typename KeyContainer = std::vector<Key>,
+          typename ValueContainer = std::vector<Value>>
+class SoAContainer {
+  KeyContainer keys_{};
+  ValueContainer values_{};
+
+ public:
+  using value_type = std::pair<Key, Value>;
+  using reference = SoAReference<Key, Value>;
+  using const_reference = SoAReference<const Key, const Value>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <bool Const>
+  class Iterator {
+    friend class SoAContainer;
+    friend class Iterator<!Const>;
+
+    using owner_type = std::conditional_t<Const, const SoAContainer, SoAContainer>;
+
+    owner_type* owner_ = nullptr;
+    std::ptrdiff_t index_ = 0;
+
+    Iterator(owner_type* owner, std::ptrdiff_t index) noexcept : owner_(owner), index_(index) {}
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename SoAContainer::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, const_reference, typename SoAContainer::reference>;
+
+    /// `operator->` has to return something that outlives the call.
+    struct pointer {
+      reference ref;
+      reference* operator->() noexcept { return std::addressof(ref); }
+    };
+
+    Iterator() noexcept = default;
+
+    /// from iterator to const_iterator.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    Iterator(const Iterator<false>& other) noexcept : owner_(other.owner_), index_(other.index_) {}
+
+    reference operator*() const noexcept { return (*owner_)[static_cast<size_type>(index_)]; }
+    reference operator[](difference_type n) const noexcept { return *(*this + n); }
+    pointer operator->() const noexcept { return pointer{**this}; }
+
+    Iterator& operator++() noexcept { ++index_; return *this; }
+    Iterator& operator--() noexcept { --index_; return *this; }
+    Iterator operator++(int) noexcept { auto copy = *this; ++index_; return copy; }
+    Iterator operator--(int) noexcept { auto copy = *this; --index_; return copy; }
+
+    Iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+    Iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+
+    friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+      return lhs.index_ - rhs.index_;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ == rhs.index_; }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ != rhs.index_; }
+    friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ < rhs.index_; }
+    friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ > rhs.index_; }
+    friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ <= rhs.index_; }
+    friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs.index_ >= rhs.index_; }
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  SoAContainer() noexcept {}
+
+  SoAContainer(std::initializer_list<value_type> entries) {
+    insert(end(), entries.begin(), entries.end());
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return std::size(keys_); }
+  [[nodiscard]] auto empty() const noexcept -> bool { return std::empty(keys_); }
+
+  void reserve(size_type n) {
+    keys_.reserve(n);
+    values_.reserve(n);
+  }
+
+  void clear() noexcept {
+    keys_.clear();
+    values_.clear();
+  }
+
+  /// the dense key array.
+  [[nodiscard]] auto keys() const noexcept -> const KeyContainer& { return keys_; }
+  [[nodiscard]] auto values() const noexcept -> const ValueContainer& { return values_; }
+
+  reference operator[](size_type index) noexcept { return reference(keys_[index], values_[index]); }
+  const_reference operator[](size_type index) const noexcept { return const_reference(keys_[index], values_[index]); }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+  iterator end() noexcept { return iterator(this, static_cast<difference_type>(size())); }
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+  const_iterator end() const noexcept { return const_iterator(this, static_cast<difference_type>(size())); }
+
+  template <typename K, typename V>
+  iterator emplace(const_iterator pos, K&& key, V&& value) {
+    const auto index = pos.index_;
+    keys_.emplace(std::begin(keys_) + index, std::forward<K>(key));
+    try {
+      values_.emplace(std::begin(values_) + index, std::forward<V>(value));
+    } catch (...) {
+      keys_.erase(std::begin(keys_) + index);
+      throw;
+    }
+    return iterator(this, index);
+  }
+
+  template <typename K, typename V>
+  reference emplace_back(K&& key, V&& value) {
+    return *emplace(end(), std::forward<K>(key), std::forward<V>(value));
+  }
+
+  /// inserts pairs (or move_iterators over pairs), moving both arrays once.
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    const auto index = pos.index_;
+    const auto old_size = static_cast<difference_type>(size());
+    try {
+      for (; first != last; ++first) {
+        auto&& entry = *first;
+        keys_.emplace_back(std::forward<decltype(entry)>(entry).first);
+        values_.emplace_back(std::forward<decltype(entry)>(entry).second);
+      }
+    } catch (...) {
+      // both arrays must keep the same size.
+      keys_.erase(std::begin(keys_) + old_size, std::end(keys_));
+      values_.erase(std::begin(values_) + old_size, std::end(values_));
+      throw;
+    }
+    std::rotate(std::begin(keys_) + index, std::begin(keys_) + old_size, std::end(keys_));
+    std::rotate(std::begin(values_) + index, std::begin(values_) + old_size, std::end(values_));
+    return iterator(this, index);
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    keys_.erase(std::begin(keys_) + first.index_, std::begin(keys_) + last.index_);
+    values_.erase(std::begin(values_) + first.index_, std::begin(values_) + last.index_);
+    return iterator(this, first.index_);
+  }
+
+  void pop_back() {
+    keys_.pop_back();
+    values_.pop_back();
+  }
+};
+
+/// `FlatMap` searching a dense key array, values kept apart.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using SoAFlatMap = FlatMap<Key, Value, Compare, SoAContainer<Key, Value>>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_SOA_CONTAINER_HPP_
@@ -0,0 +1,514 @@
+#ifndef TOYPP_SWISS_MAP_HPP_
+#define TOYPP_SWISS_MAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TOYPP_SWISS_HAS_SSE2 1
+#endif
+
+namespace tpp {
+
+/// bit `i` set = control byte `i` of the group matched.
+using SwissMask = std::uint32_t;
+
+namespace detail {
+
+inline auto swiss_first_bit(SwissMask mask) noexcept -> unsigned {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+  unsigned index = 0;
+  for (; !(mask & 1u); mask >>= 1) {
+    ++index;
+  }
+  return index;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Control bytes of a `SwissMap` slot: empty, deleted (tombstone),
+ * or full with the 7 low bits of the hash (`h2`).
+ */
+struct SwissCtrl {
+  static constexpr std::uint8_t empty = 0x80;
+  static constexpr std::uint8_t deleted = 0xFE;
+  static constexpr std::size_t group_width = 16;
+
+  static constexpr bool is_full(std::uint8_t ctrl) noexcept { return !(ctrl & 0x80); }
+};
+
+/**
+ * Portable group: 16 control bytes matched as two 64-bit words (SWAR).
+ */
+class SwissScalarGroup {
+  static constexpr std::uint64_t k_lsbs = 0x0101010101010101ull;
+  static constexpr std::uint64_t k_msbs = 0x8080808080808080ull;
+
+  std::uint64_t words_[2];
+
+  /// exact: 0x80 in every zero byte of `word`, nothing elsewhere.
+  static constexpr auto zero_bytes(std::uint64_t word) noexcept -> std::uint64_t {
+    return ~(((word & ~k_msbs) + ~k_msbs) | word | ~k_msbs);
+  }
+
+  /// gathers the high bit of every byte into an 8-bit mask.
+  static constexpr auto gather(std::uint64_t high_bits) noexcept -> SwissMask {
+    return static_cast<SwissMask>(((high_bits >> 7) * 0x0102040810204080ull) >> 56);
+  }
+
+  auto gather_both(std::uint64_t low, std::uint64_t high) const noexcept -> SwissMask {
+    return gather(low) | (gather(high) << 8);
+  }
+
+ public:
+  explicit SwissScalarGroup(const std::uint8_t* ctrl) noexcept : words_{0, 0} {
+    // control byte `i` goes to bits [8i, 8i+8) whatever the endianness (a plain load on little-endian).
+    for (std::size_t index = 0; index < SwissCtrl::group_width; ++index) {
+      words_[index / 8] |= std::uint64_t{ctrl[index]} << (8 * (index % 8));
+    }
+  }
+
+  [[nodiscard]] auto match(std::uint8_t h2) const noexcept -> SwissMask {
+    const auto pattern = k_lsbs * h2;
+    return gather_both(zero_bytes(words_[0] ^ pattern), zero_bytes(words_[1] ^ pattern));
+  }
+
+  [[nodiscard]] auto match_empty() const noexcept -> SwissMask {
+    return match(SwissCtrl::empty);
+  }
+
+  [[nodiscard]] auto match_empty_or_deleted() const noexcept -> SwissMask {
+    return gather_both(words_[0] & k_msbs, words_[1] & k_msbs);
+  }
+};
+
+#if defined(TOYPP_SWISS_HAS_SSE2)
+
+/**
+ * SSE2 group: one compare and one `movemask` per query.
+ * (16 bytes fill a single SSE2 register, so AVX2 brings nothing here.)
+ */
+class SwissSse2Group {
+  __m128i ctrl_;
+
+ public:
+  explicit SwissSse2Group(const std::uint8_t* ctrl) noexcept
+    : ctrl_(_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl)))
+  {}
+
+  [[nodiscard]] auto match(std::uint8_t h2) const noexcept -> SwissMask {
+    const auto pattern = _mm_set1_epi8(static_cast<char>(h2));
+    return static_cast<SwissMask>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, pattern)));
+  }
+
+  [[nodiscard]] auto match_empty() const noexcept -> SwissMask {
+    return match(SwissCtrl::empty);
+  }
+
+  [[nodiscard]] auto match_empty_or_deleted() const noexcept -> SwissMask {
+    return static_cast<SwissMask>(_mm_movemask_epi8(ctrl_));
+  }
+};
+
+using SwissDefaultGroup = SwissSse2Group;
+
+#else
+
+using SwissDefaultGroup = SwissScalarGroup;
+
+#endif
+
+/**
+ * @brief Open-addressing hash map probing 16 control bytes at a time (Swiss table).
+ *
+ * Slots are split into aligned groups of 16, each with one control byte per
+ * slot holding 7 bits of the hash. A lookup hashes to a group and matches
+ * all its control bytes at once through `Group` (SSE2 when available, SWAR
+ * otherwise), only comparing keys on a control match; it stops at the first
+ * group with an empty slot, and otherwise probes groups quadratically.
+ * Removal leaves a tombstone unless the group still has an empty slot.
+ *
+ * Same interface as `FlatHashMap`; lookups take any `K` when both `Hash`
+ * and `KeyEqual` are transparent.
+ */
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Group = SwissDefaultGroup>
+class SwissMap {
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+
+ private:
+  static constexpr std::size_t k_width = SwissCtrl::group_width;
+  static constexpr std::size_t k_npos = ~std::size_t{0};
+
+  union Slot {
+    value_type value;
+
+    Slot() noexcept {}
+    ~Slot() {}
+  };
+
+  struct alignas(16) CtrlGroup {
+    std::uint8_t bytes[k_width];
+  };
+
+  template <typename H, typename = void>
+  struct has_is_transparent : std::false_type {};
+
+  template <typename H>
+  struct has_is_transparent<H, std::void_t<typename H::is_transparent>> : std::true_type {};
+
+  template <typename K>
+  using enable_heterogeneous_t = std::enable_if_t<has_is_transparent<Hash>::value
+                                               && has_is_transparent<KeyEqual>::value
+                                               && !std::is_same_v<std::decay_t<K>, Key>, int>;
+
+  struct HashParts {
+    std::size_t group;
+    std::uint8_t h2;
+  };
+
+  std::unique_ptr<CtrlGroup[]> ctrl_;
+  std::unique_ptr<Slot[]> slots_;
+  std::size_t capacity_ = 0;
+  std::size_t group_mask_ = 0;
+  std::size_t size_ = 0;
+  std::size_t deleted_ = 0;
+  unsigned shift_ = 64;
+
+ public:
+  /// forward iterator over the entries, in slot order.
+  class const_iterator {
+    friend class SwissMap;
+
+    const SwissMap* owner_ = nullptr;
+    std::size_t index_ = 0;
+
+    const_iterator(const SwissMap* owner, std::size_t index) noexcept
+      : owner_(owner), index_(index)
+    {
+      skip_empty();
+    }
+
+    void skip_empty() noexcept {
+      while (index_ < owner_->capacity_ && !SwissCtrl::is_full(owner_->ctrl_at(index_))) {
+        ++index_;
+      }
+    }
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename SwissMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() noexcept = default;
+
+    reference operator*() const noexcept { return owner_->slots_[index_].value; }
+    pointer operator->() const noexcept { return std::addressof(**this); }
+
+    const_iterator& operator++() noexcept {
+      ++index_;
+      skip_empty();
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return lhs.index_ == rhs.index_;
+    }
+
+    friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+      return !(lhs == rhs);
+    }
+  };
+
+  SwissMap() noexcept {}
+
+  SwissMap(const SwissMap& other) {
+    if (other.empty()) return;
+    reserve(other.size_);
+    try {
+      for (const auto& entry : other) {
+        place(value_type(entry));
+      }
+    } catch (...) {
+      destroy_all();
+      throw;
+    }
+  }
+
+  SwissMap(SwissMap&& other) noexcept
+    : ctrl_(std::move(other.ctrl_))
+    , slots_(std::move(other.slots_))
+    , capacity_(std::exchange(other.capacity_, 0))
+    , group_mask_(std::exchange(other.group_mask_, 0))
+    , size_(std::exchange(other.size_, 0))
+    , deleted_(std::exchange(other.deleted_, 0))
+    , shift_(std::exchange(other.shift_, 64))
+  {}
+
+  SwissMap& operator=(SwissMap other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~SwissMap() { destroy_all(); }
+
+  void swap(SwissMap& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(group_mask_, other.group_mask_);
+    std::swap(size_, other.size_);
+    std::swap(deleted_, other.deleted_);
+    std::swap(shift_, other.shift_);
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  [[nodiscard]] auto load_factor() const noexcept -> double {
+    return capacity_ == 0 ? 0.0 : static_cast<double>(size_) / static_cast<double>(capacity_);
+  }
+
+  /// makes room for `n` entries without growing (up to a 7/8 load factor).
+  void reserve(std::size_t n) {
+    std::size_t capacity = k_width;
+    while (max_size_for(capacity) < n) {
+      capacity <<= 1;
+    }
+    if (capacity > capacity_) {
+      rehash(capacity);
+    }
+  }
+
+  void clear() noexcept {
+    destroy_all();
+    size_ = 0;
+    deleted_ = 0;
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return const_iterator(this, 0); }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return const_iterator(this, capacity_); }
+
+  Value* at(const Key& key) noexcept { return value_at(find_index(key)); }
+  const Value* at(const Key& key) const noexcept { return value_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  Value* at(const K& key) noexcept { return value_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  const Value* at(const K& key) const noexcept { return value_at(find_index(key)); }
+
+  bool contains(const Key& key) const noexcept { return find_index(key) != k_npos; }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  bool contains(const K& key) const noexcept { return find_index(key) != k_npos; }
+
+  /// @return false if `key` is already there and `can_override` is not set.
+  bool insert(Key key, Value value, bool can_override = false) {
+    const auto index = find_index(key);
+    if (index != k_npos) {
+      if (!can_override) return false;
+      slots_[index].value.second = std::move(value);
+      return true;
+    }
+
+    reserve_one();
+    place(value_type(std::move(key), std::move(value)));
+    return true;
+  }
+
+  bool insert_or_assign(Key key, Value value) {
+    return insert(std::move(key), std::move(value), true);
+  }
+
+  bool remove(const Key& key) { return remove_at(find_index(key)); }
+
+  template <typename K, enable_heterogeneous_t<K> = 0>
+  bool remove(const K& key) { return remove_at(find_index(key)); }
+
+  Value& operator[](const Key& key) {
+    auto index = find_index(key);
+    if (index == k_npos) {
+      reserve_one();
+      index = place(value_type(key, Value{}));
+    }
+    return slots_[index].value.second;
+  }
+
+ private:
+  static constexpr auto max_size_for(std::size_t capacity) noexcept -> std::size_t {
+    return capacity - capacity / 8;
+  }
+
+  auto ctrl_at(std::size_t index) const noexcept -> std::uint8_t {
+    return ctrl_[index / k_width].bytes[index % k_width];
+  }
+
+  void set_ctrl(std::size_t index, std::uint8_t ctrl) noexcept {
+    ctrl_[index / k_width].bytes[index % k_width] = ctrl;
+  }
+
+  /// fibonacci hashing: the top bits pick the group, the 7 bits right below are `h2`.
+  template <typename K>
+  auto split_hash(const K& key) const noexcept -> HashParts {
+    const auto hash = static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+    const auto group = shift_ == 64 ? 0 : static_cast<std::size_t>(hash >> shift_);
+    const auto h2 = static_cast<std::uint8_t>((hash >> (shift_ - 7)) & 0x7F);
+    return {group, h2};
+  }
+
+  template <typename K>
+  auto find_index(const K& key) const noexcept -> std::size_t {
+    if (size_ == 0) return k_npos;
+
+    auto [group, h2] = split_hash(key);
+    for (std::size_t step = 1;; ++step) {
+      const Group ctrl(ctrl_[group].bytes);
+      for (auto mask = ctrl.match(h2); mask != 0; mask &= mask - 1) {
+        const auto index = group * k_width + detail::swiss_first_bit(mask);
+        if (KeyEqual{}(slots_[index].value.first, key)) return index;
+      }
+      if (ctrl.match_empty() != 0) return k_npos;
+      group = (group + step) & group_mask_;
+    }
+  }
+
+  auto value_at(std::size_t index) const noexcept -> Value* {
+    return index == k_npos ? nullptr : std::addressof(slots_[index].value.second);
+  }
+
+  void reserve_one() {
+    if (size_ + deleted_ + 1 <= max_size_for(capacity_)) return;
+
+    // mostly tombstones: clean them up in place instead of growing.
+    const bool grow = capacity_ == 0 || size_ + 1 > max_size_for(capacity_) / 2;
+    rehash(capacity_ == 0 ? k_width : grow ? capacity_ * 2 : capacity_);
+  }
+
+  /// inserts a key known to be absent, in the first free slot of its probe sequence.
+  auto place(value_type entry) -> std::size_t {
+    auto [group, h2] = split_hash(entry.first);
+    for (std::size_t step = 1;; ++step) {
+      const auto mask = Group(ctrl_[group].bytes).match_empty_or_deleted();
+      if (mask != 0) {
+        const auto index = group * k_width + detail::swiss_first_bit(mask);
+        if (ctrl_at(index) == SwissCtrl::deleted) {
+          --deleted_;
+        }
+        ::new (std::addressof(slots_[index].value)) value_type(std::move(entry));
+        set_ctrl(index, h2);
+        ++size_;
+        return index;
+      }
+      group = (group + step) & group_mask_;
+    }
+  }
+
+  bool remove_at(std::size_t index) {
+    if (index == k_npos) return false;
+
+    slots_[index].value.~value_type();
+    --size_;
+
+    // probes stop at a group with an empty slot, so none needs to go past this one.
+    const auto group = index / k_width;
+    if (Group(ctrl_[group].bytes).match_empty() != 0) {
+      set_ctrl(index, SwissCtrl::empty);
+    } else {
+      set_ctrl(index, SwissCtrl::deleted);
+      ++deleted_;
+    }
+    return true;
+  }
+
+  void rehash(std::size_t capacity) {
+    const auto groups = capacity / k_width;
+    auto new_ctrl = std::make_unique<CtrlGroup[]>(groups);
+    for (std::size_t group = 0; group < groups; ++group) {
+      std::memset(new_ctrl[group].bytes, SwissCtrl::empty, k_width);
+    }
+
+    auto new_slots = std::make_unique<Slot[]>(capacity);
+
+    auto old_ctrl = std::exchange(ctrl_, std::move(new_ctrl));
+    auto old_slots = std::exchange(slots_, std::move(new_slots));
+    const auto old_capacity = std::exchange(capacity_, capacity);
+    const auto old_group_mask = std::exchange(group_mask_, groups - 1);
+    const auto old_shift = std::exchange(shift_, 64);
+    const auto old_size = std::exchange(size_, 0);
+    const auto old_deleted = std::exchange(deleted_, 0);
+
+    for (auto n = groups; n > 1; n >>= 1) {
+      --shift_;
+    }
+
+    const auto is_full = [&old_ctrl](std::size_t index) {
+      return SwissCtrl::is_full(old_ctrl[index / k_width].bytes[index % k_width]);
+    };
+
+    // entries are copied unless they move without throwing, so a throw leaves the old table whole.
+    try {
+      for (std::size_t index = 0; index < old_capacity; ++index) {
+        if (is_full(index)) {
+          place(std::move_if_noexcept(old_slots[index].value));
+        }
+      }
+    } catch (...) {
+      destroy_all();
+      ctrl_ = std::move(old_ctrl);
+      slots_ = std::move(old_slots);
+      capacity_ = old_capacity;
+      group_mask_ = old_group_mask;
+      shift_ = old_shift;
+      size_ = old_size;
+      deleted_ = old_deleted;
+      throw;
+    }
+
+    for (std::size_t index = 0; index < old_capacity; ++index) {
+      if (is_full(index)) {
+        old_slots[index].value.~value_type();
+      }
+    }
+  }
+
+  void destroy_all() noexcept {
+    for (std::size_t index = 0; index < capacity_; ++index) {
+      if (SwissCtrl::is_full(ctrl_at(index))) {
+        slots_[index].value.~value_type();
+      }
+      set_ctrl(index, SwissCtrl::empty);
+    }
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_SWISS_MAP_HPP_
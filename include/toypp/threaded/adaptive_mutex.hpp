@@ -0,0 +1,82 @@
+#ifndef TOYPP_THREADED_ADAPTIVE_MUTEX_HPP_
+#define TOYPP_THREADED_ADAPTIVE_MUTEX_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "toypp/threaded/cpu_relax.hpp"
+#include "toypp/threaded/futex.hpp"
+
+namespace tpp {
+
+/**
+ * Spin-then-park mutex.
+ *
+ * A contended `lock` first spins, hoping the owner is about to release it;
+ * the spin budget is calibrated on the fly from how long past acquisitions
+ * had to spin (a moving average, capped at `MaxSpins`). When the budget runs
+ * out, the thread parks on a futex, so a descheduled owner doesn't make the
+ * waiters burn their cpu. `unlock` only issues a wake-up when someone parked.
+ *
+ * Same interface as SpinMutex (Lockable).
+ */
+template <std::uint32_t MaxSpins = 4096>
+class BasicAdaptiveMutex {
+  static constexpr std::uint32_t k_unlocked = 0;
+  static constexpr std::uint32_t k_locked = 1;
+  static constexpr std::uint32_t k_contended = 2;  // locked, and maybe someone parked.
+
+  std::atomic<std::uint32_t> state_{k_unlocked};
+  std::atomic<std::uint32_t> spin_estimate_{64};
+
+ public:
+  BasicAdaptiveMutex() {}
+  BasicAdaptiveMutex(const BasicAdaptiveMutex&) = delete;
+
+  void lock() noexcept {
+    if (try_lock())
+      return;
+
+    const auto estimate = spin_estimate_.load(std::memory_order_relaxed);
+    const auto max_spins = std::min<std::uint32_t>(MaxSpins, estimate * 2 + 16);
+
+    for (std::uint32_t spins = 0; spins < max_spins; ++spins) {
+      cpu_relax();
+      if (state_.load(std::memory_order_relaxed) == k_unlocked && try_lock()) {
+        calibrate(estimate, spins);
+        return;
+      }
+    }
+    calibrate(estimate, max_spins);
+
+    auto state = state_.exchange(k_contended, std::memory_order_acquire);
+    while (state != k_unlocked) {
+      futex_wait(state_, k_contended);
+      state = state_.exchange(k_contended, std::memory_order_acquire);
+    }
+  }
+
+  bool try_lock() noexcept {
+    auto expected = k_unlocked;
+    return state_.compare_exchange_strong(expected, k_locked, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    if (state_.exchange(k_unlocked, std::memory_order_release) == k_contended)
+      futex_wake_one(state_);
+  }
+
+ private:
+  void calibrate(std::uint32_t estimate, std::uint32_t spins) noexcept {
+    // estimate += (spins - estimate) / 8, in unsigned arithmetic.
+    const auto updated = (estimate * 7 + spins) / 8;
+    spin_estimate_.store(updated, std::memory_order_relaxed);
+  }
+};
+
+using AdaptiveMutex = BasicAdaptiveMutex<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_ADAPTIVE_MUTEX_HPP_
@@ -0,0 +1,210 @@
+#ifndef TOYPP_THREADED_ATOMIC_SNAPSHOT_HPP_
+#define TOYPP_THREADED_ATOMIC_SNAPSHOT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "toypp/sharedptr.hpp"
+
+namespace tpp {
+
+/**
+ * @brief RCU-style cell for a read-mostly value.
+ *
+ * Reads are wait-free: `read()` bumps a per-thread striped counter of the
+ * current epoch and loads the pointer, no lock and no refcount involved.
+ * Updates are copy-on-write: the writer publishes a new `SharedPtr<T>` and
+ * waits for a grace period (every reader of the previous epochs left), then
+ * drops the old one, so its deleter runs through `SharedPtr` as usual.
+ * `update_deferred` doesn't wait: the old value is dropped by a later update
+ * once its readers left.
+ *
+ * @tparam T value type.
+ * @tparam Stripes number of reader counters per epoch, to spread contention.
+ */
+template <typename T, std::size_t Stripes = 16>
+class AtomicSnapshot {
+ public:
+  using value_type = T;
+  using pointer_type = SharedPtr<T>;
+
+ private:
+  struct Node {
+    pointer_type ptr;
+  };
+
+  struct alignas(64) ReaderCounter {
+    std::atomic<std::size_t> count{0};
+  };
+
+  ReaderCounter _readers[2][Stripes] = {};
+  alignas(64) std::atomic<std::size_t> _epoch{0};
+  alignas(64) std::atomic<Node*> _current{nullptr};
+  std::mutex _writer_mutex;
+
+  // deferred reclamation, under the writer mutex: `_retired` waits for the next
+  // grace period, `_grace` is in one (`_grace_flips` epoch flips drained so far).
+  std::vector<Node*> _retired;
+  std::vector<Node*> _grace;
+  int _grace_flips = 0;
+  bool _draining = false;
+  std::size_t _drain_parity = 0;
+
+ public:
+  /**
+   * Keeps the snapshot alive (and unchanged) for as long as it exists.
+   * Meant to be short-lived, as it holds back reclamation of older snapshots.
+   */
+  class ReadGuard {
+    friend class AtomicSnapshot;
+
+    std::atomic<std::size_t>* _counter = nullptr;
+    const Node* _node = nullptr;
+
+    explicit ReadGuard(AtomicSnapshot& owner) noexcept {
+      const auto parity = owner._epoch.load(std::memory_order_seq_cst) & 1;
+      _counter = &owner._readers[parity][stripe_index()].count;
+      _counter->fetch_add(1, std::memory_order_seq_cst);
+      _node = owner._current.load(std::memory_order_seq_cst);
+    }
+
+   public:
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    ~ReadGuard() { _counter->fetch_sub(1, std::memory_order_release); }
+
+    const value_type* get() const noexcept { return _node->ptr.get(); }
+
+    const value_type& operator*() const noexcept { return *get(); }
+    const value_type* operator->() const noexcept { return get(); }
+
+    explicit operator bool() const noexcept { return get() != nullptr; }
+  };
+
+  AtomicSnapshot() : AtomicSnapshot(pointer_type{}) {}
+
+  explicit AtomicSnapshot(pointer_type ptr) : _current(new Node{std::move(ptr)}) {}
+
+  AtomicSnapshot(const AtomicSnapshot&) = delete;
+  AtomicSnapshot& operator=(const AtomicSnapshot&) = delete;
+
+  /// no reader may outlive the cell.
+  ~AtomicSnapshot() {
+    for (auto* node : _grace) {
+      delete node;
+    }
+    for (auto* node : _retired) {
+      delete node;
+    }
+    delete _current.load(std::memory_order_relaxed);
+  }
+
+  /// wait-free read access to the current value.
+  ReadGuard read() noexcept { return ReadGuard(*this); }
+
+  /// a counted reference to the current value, for keeping it past a read guard.
+  pointer_type load() noexcept {
+    const auto guard = read();
+    return guard._node->ptr;
+  }
+
+  /**
+   * Publishes `ptr`, and returns once no reader can see the previous value anymore.
+   * Must not be called while the calling thread holds a read guard.
+   */
+  void store(pointer_type ptr) {
+    auto* node = new Node{std::move(ptr)};
+    std::lock_guard lock{_writer_mutex};
+    retire(_current.exchange(node, std::memory_order_seq_cst));
+  }
+
+  /**
+   * Copy-on-write update: `f(T&)` edits a copy of the current value, which is then published.
+   * Requires a non-empty snapshot.
+   */
+  template <typename F>
+  void update(F&& f) {
+    std::lock_guard lock{_writer_mutex};
+    auto copy = tpp::make_shared<T>(*_current.load(std::memory_order_relaxed)->ptr);
+    std::forward<F>(f)(*copy);
+    auto* node = new Node{std::move(copy)};
+    retire(_current.exchange(node, std::memory_order_seq_cst));
+  }
+
+  /**
+   * Like `update`, but never waits for readers, so it may be called while the
+   * calling thread holds a read guard. The previous value is dropped by a later
+   * `update_deferred` (or the destructor), once no reader can see it anymore.
+   */
+  template <typename F>
+  void update_deferred(F&& f) {
+    std::lock_guard lock{_writer_mutex};
+    auto copy = tpp::make_shared<T>(*_current.load(std::memory_order_relaxed)->ptr);
+    std::forward<F>(f)(*copy);
+    _retired.reserve(_retired.size() + 1);
+    auto* node = new Node{std::move(copy)};
+    _retired.push_back(_current.exchange(node, std::memory_order_seq_cst));
+    reclaim();
+  }
+
+ private:
+  static std::size_t stripe_index() noexcept {
+    static std::atomic<std::size_t> next{0};
+    thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % Stripes;
+    return index;
+  }
+
+  /// waits for a grace period, then drops `node` (and its reference).
+  void retire(Node* node) {
+    // two flips: a reader that loaded the epoch before the first flip
+    // may still register on the old parity right after it.
+    for (int phase = 0; phase < 2; ++phase) {
+      const auto parity = _epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+      for (auto& reader : _readers[parity]) {
+        while (reader.count.load(std::memory_order_acquire) != 0) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    delete node;
+  }
+
+  /// moves the deferred grace period along as far as the readers allow, without waiting.
+  void reclaim() noexcept {
+    while (true) {
+      if (_draining) {
+        for (const auto& reader : _readers[_drain_parity]) {
+          if (reader.count.load(std::memory_order_acquire) != 0) {
+            return;
+          }
+        }
+        _draining = false;
+        ++_grace_flips;
+      }
+      // the same two flips as `retire`, each drained before the next.
+      if (!_grace.empty() && _grace_flips < 2) {
+        _drain_parity = _epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+        _draining = true;
+        continue;
+      }
+      for (auto* node : _grace) {
+        delete node;
+      }
+      _grace.clear();
+      if (_retired.empty()) {
+        return;
+      }
+      _grace.swap(_retired);
+      _grace_flips = 0;
+    }
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_ATOMIC_SNAPSHOT_HPP_
@@ -0,0 +1,81 @@
+#ifndef TOYPP_THREADED_BARRIER_HPP_
+#define TOYPP_THREADED_BARRIER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "toypp/threaded/wait_strategy.hpp"
+
+namespace tpp {
+
+/// default `BasicBarrier` completion: does nothing.
+struct EmptyCompletion {
+  void operator()() noexcept {}
+};
+
+/**
+ * Reusable sense-reversing barrier.
+ *
+ * Each phase, `expected` threads arrive; the last one runs `completion()`,
+ * rearms the counter and flips the phase, which releases the others.
+ * Waiters only compare the phase against the one they arrived in, so a fast
+ * thread can arrive at the next phase while slow ones are still leaving.
+ * The phase is a counter instead of a single sense bit, so that a waiter
+ * descheduled for a whole phase can't miss the flip.
+ *
+ * Like `std::barrier`, without arrival tokens.
+ *
+ * @tparam CompletionFunction run once per phase, by the last arriving thread.
+ * @tparam WaitStrategy see wait_strategy.hpp.
+ */
+template <typename CompletionFunction = EmptyCompletion, typename WaitStrategy = FutexWait>
+class BasicBarrier {
+  alignas(64) std::atomic<std::uint32_t> remaining_;
+  alignas(64) std::atomic<std::uint32_t> phase_{0};
+  std::atomic<std::uint32_t> expected_;
+  CompletionFunction completion_;
+  WaitStrategy wait_;
+
+ public:
+  explicit BasicBarrier(std::uint32_t expected, CompletionFunction completion = CompletionFunction())
+    : remaining_(expected)
+    , expected_(expected)
+    , completion_(std::move(completion))
+  {}
+  BasicBarrier(const BasicBarrier&) = delete;
+  BasicBarrier& operator=(const BasicBarrier&) = delete;
+
+  /// arrives, and blocks until every thread arrived at this phase.
+  void arrive_and_wait() {
+    const auto phase = phase_.load(std::memory_order_acquire);
+    if (!arrive()) {
+      wait_.wait_until([this, phase] { return phase_.load(std::memory_order_acquire) != phase; });
+    }
+  }
+
+  /// arrives at this phase, and leaves the barrier: later phases expect one thread less.
+  void arrive_and_drop() {
+    expected_.fetch_sub(1, std::memory_order_relaxed);
+    arrive();
+  }
+
+ private:
+  /// @return true if this arrival completed the phase.
+  bool arrive() {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return false;
+    }
+    completion_();
+    remaining_.store(expected_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    phase_.fetch_add(1, std::memory_order_release);
+    wait_.notify();
+    return true;
+  }
+};
+
+using Barrier = BasicBarrier<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_BARRIER_HPP_
@@ -0,0 +1,182 @@
+#ifndef TOYPP_THREADED_BROADCAST_BUFFER_HPP_
+#define TOYPP_THREADED_BROADCAST_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace tpp {
+
+/**
+ * @brief DoubleBuffer generalized to one writer and up to `MaxReaders` readers.
+ *
+ * The writer fills `writer_buffer()` and publishes it as the latest snapshot.
+ * Each reader pins the snapshot it is reading in its own slot (like a hazard
+ * pointer), so the writer only recycles buffers that nobody pins.
+ * With `MaxReaders + 2` buffers there is always a free one: readers never
+ * block, and the writer never waits on a stalled reader.
+ *
+ * The recycled writer buffer holds an older snapshot, so the writer should
+ * overwrite it entirely before publishing.
+ *
+ * @tparam BufferT buffer type.
+ * @tparam MaxReaders how many readers can be registered at the same time.
+ */
+template <typename BufferT, std::size_t MaxReaders = 8>
+class BroadcastBuffer {
+ public:
+  using buffer_type = BufferT;
+
+  static constexpr std::size_t max_readers = MaxReaders;
+
+ private:
+  static constexpr std::size_t k_slot_count = MaxReaders + 2;
+  static constexpr std::uint32_t k_no_slot = ~std::uint32_t{0};
+
+  static_assert(MaxReaders > 0, "at least one reader is needed.");
+  static_assert(k_slot_count <= 64, "pinned slots are gathered into a 64-bit mask.");
+
+  struct alignas(64) Slot {
+    buffer_type buffer{};
+  };
+
+  struct alignas(64) ReaderState {
+    std::atomic<std::uint32_t> pinned{k_no_slot};
+    std::atomic<bool> taken{false};
+  };
+
+  Slot _slots[k_slot_count] = {};
+  ReaderState _readers[MaxReaders] = {};
+  alignas(64) std::atomic<std::uint32_t> _latest{0};
+  alignas(64) std::uint32_t _writer_index = 1;
+
+ public:
+  /**
+   * A registered reader; unregisters itself when destroyed.
+   */
+  class Reader {
+    friend class BroadcastBuffer;
+
+    BroadcastBuffer* _owner = nullptr;
+    std::size_t _id = 0;
+    std::uint32_t _current = k_no_slot;
+
+    Reader(BroadcastBuffer* owner, std::size_t id) noexcept : _owner(owner), _id(id) {
+      reader_arrive();
+    }
+
+   public:
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    Reader(Reader&& other) noexcept
+      : _owner(std::exchange(other._owner, nullptr))
+      , _id(other._id)
+      , _current(other._current)
+    {}
+
+    Reader& operator=(Reader&& other) noexcept {
+      if (this != &other) {
+        unregister();
+        _owner = std::exchange(other._owner, nullptr);
+        _id = other._id;
+        _current = other._current;
+      }
+      return *this;
+    }
+
+    ~Reader() { unregister(); }
+
+    /// moves to the latest snapshot; @return true if it's a new one.
+    bool reader_arrive() noexcept {
+      auto& pinned = _owner->_readers[_id].pinned;
+      auto latest = _owner->_latest.load(std::memory_order_seq_cst);
+      if (latest == _current) {
+        return false;
+      }
+
+      // the pin counts only if the snapshot is still the latest after pinning;
+      // otherwise the writer may already be recycling it.
+      while (true) {
+        pinned.store(latest, std::memory_order_seq_cst);
+        const auto check = _owner->_latest.load(std::memory_order_seq_cst);
+        if (check == latest) {
+          _current = latest;
+          return true;
+        }
+        latest = check;
+      }
+    }
+
+    const buffer_type& reader_buffer() const noexcept {
+      return _owner->_slots[_current].buffer;
+    }
+
+   private:
+    void unregister() noexcept {
+      if (!_owner) {
+        return;
+      }
+      auto& state = _owner->_readers[_id];
+      state.pinned.store(k_no_slot, std::memory_order_release);
+      state.taken.store(false, std::memory_order_release);
+      _owner = nullptr;
+    }
+  };
+
+  BroadcastBuffer() {}
+
+  explicit BroadcastBuffer(const buffer_type& initial) {
+    for (auto& slot : _slots) {
+      slot.buffer = initial;
+    }
+  }
+
+  BroadcastBuffer(const BroadcastBuffer&) = delete;
+  BroadcastBuffer& operator=(const BroadcastBuffer&) = delete;
+
+  /// @return nullopt if `MaxReaders` readers are already registered.
+  std::optional<Reader> make_reader() noexcept {
+    for (std::size_t id = 0; id < MaxReaders; ++id) {
+      bool taken = false;
+      if (_readers[id].taken.compare_exchange_strong(taken, true, std::memory_order_acq_rel)) {
+        return Reader(this, id);
+      }
+    }
+    return std::nullopt;
+  }
+
+  buffer_type& writer_buffer() noexcept {
+    return _slots[_writer_index].buffer;
+  }
+
+  const buffer_type& writer_buffer() const noexcept {
+    return _slots[_writer_index].buffer;
+  }
+
+  /// publishes the writer buffer as the latest snapshot, and picks a free one to write next.
+  void writer_publish() noexcept {
+    _latest.store(_writer_index, std::memory_order_seq_cst);
+
+    std::uint64_t busy = std::uint64_t{1} << _writer_index;
+    for (auto& reader : _readers) {
+      const auto pinned = reader.pinned.load(std::memory_order_seq_cst);
+      if (pinned != k_no_slot) {
+        busy |= std::uint64_t{1} << pinned;
+      }
+    }
+
+    for (std::uint32_t index = 0; index < k_slot_count; ++index) {
+      if (!(busy & (std::uint64_t{1} << index))) {
+        _writer_index = index;
+        return;
+      }
+    }
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_BROADCAST_BUFFER_HPP_
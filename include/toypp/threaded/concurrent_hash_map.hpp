@@ -0,0 +1,440 @@
+#ifndef TOYPP_THREADED_CONCURRENT_HASH_MAP_HPP_
+#define TOYPP_THREADED_CONCURRENT_HASH_MAP_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "toypp/flat_hash_map.hpp"
+#include "toypp/threaded/cpu_relax.hpp"
+#include "toypp/threaded/spinmutex.hpp"
+
+namespace tpp {
+
+namespace detail {
+
+/**
+ * A trivially copyable `T` spread over relaxed atomic words, so a seqlock
+ * reader may copy it while a writer overwrites it without a data race.
+ */
+template <typename T>
+class AtomicWords {
+  static constexpr std::size_t k_words = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  std::atomic<std::uint64_t> words_[k_words] = {};
+
+ public:
+  void store(const T& value) noexcept {
+    std::uint64_t buffer[k_words] = {};
+    std::memcpy(buffer, std::addressof(value), sizeof(T));
+    for (std::size_t i = 0; i < k_words; ++i) {
+      words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] T load() const noexcept {
+    std::uint64_t buffer[k_words];
+    for (std::size_t i = 0; i < k_words; ++i) {
+      buffer[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    T value;
+    std::memcpy(std::addressof(value), buffer, sizeof(T));
+    return value;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Hash map shared between threads, split into `Shards` independently locked shards.
+ *
+ * A key picks its shard from the top bits of its (mixed) hash; writers lock
+ * only that shard's `SpinMutex`, so threads touching different shards never
+ * contend.
+ *
+ * When `Key` and `Value` are trivially copyable, reads take no lock: a shard
+ * is an open-addressing table of atomic words guarded by a version counter
+ * (seqlock). A reader probes a snapshot, then retries if a writer bumped the
+ * version meanwhile. Tables replaced by growth are kept until the map dies,
+ * so a racing reader never touches freed memory (each is half the next one,
+ * so they add up to less than the live table). Other types fall back to locking the shard for reads too.
+ *
+ * Values are returned by copy: nothing points into a shard once its lock is released.
+ */
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          std::size_t Shards = 64>
+class ConcurrentHashMap {
+  static_assert(Shards > 0 && (Shards & (Shards - 1)) == 0, "the shard count must be a power of two.");
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+
+  /// whether `get` is lock-free (optimistic) for these types.
+  static constexpr bool optimistic_reads = std::is_trivially_copyable_v<Key>
+                                        && std::is_trivially_copyable_v<Value>
+                                        && std::is_default_constructible_v<Key>
+                                        && std::is_default_constructible_v<Value>;
+
+ private:
+  static constexpr unsigned k_shard_bits = [] {
+    unsigned bits = 0;
+    for (auto n = Shards; n > 1; n >>= 1) ++bits;
+    return bits;
+  }();
+
+  /// seqlock shard: open addressing with linear probing over atomic slots.
+  class OptimisticShard {
+    static constexpr std::uint64_t k_empty = 0;
+    static constexpr std::uint64_t k_deleted = 1;
+    static constexpr std::size_t k_min_capacity = 16;
+    static constexpr int k_spin_count = 64;
+
+    struct Slot {
+      std::atomic<std::uint64_t> meta{k_empty};  // empty, deleted, or `hash | 2`.
+      detail::AtomicWords<Key> key;
+      detail::AtomicWords<Value> value;
+    };
+
+    struct Table {
+      std::size_t capacity;
+      std::unique_ptr<Slot[]> slots;
+
+      explicit Table(std::size_t n) : capacity(n), slots(std::make_unique<Slot[]>(n)) {}
+    };
+
+    alignas(64) std::atomic<std::uint64_t> version_{0};
+    std::atomic<Table*> table_{nullptr};
+    std::atomic<std::size_t> size_{0};
+    SpinMutex mutex_;
+    std::size_t deleted_ = 0;
+    std::vector<std::unique_ptr<Table>> tables_;  // the live one is last.
+
+    static constexpr auto full_meta(std::uint64_t hash) noexcept -> std::uint64_t { return hash | 2; }
+
+    /// skips the 2 low bits `full_meta` overwrites, so a rehash finds the same home from the meta alone.
+    static constexpr auto home_of(std::uint64_t meta, std::size_t mask) noexcept -> std::size_t {
+      return static_cast<std::size_t>(meta >> 2) & mask;
+    }
+
+   public:
+    OptimisticShard() {
+      tables_.push_back(std::make_unique<Table>(k_min_capacity));
+      table_.store(tables_.back().get(), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_.load(std::memory_order_relaxed); }
+
+    std::optional<Value> get(const Key& key, std::uint64_t hash) const noexcept {
+      for (int attempt = 0;; ++attempt) {
+        const auto before = version_.load(std::memory_order_acquire);
+        if (!(before & 1)) {
+          const auto result = probe(*table_.load(std::memory_order_acquire), key, hash);
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (version_.load(std::memory_order_relaxed) == before) {
+            return result;
+          }
+        }
+        if (attempt < k_spin_count) cpu_relax();
+        else std::this_thread::yield();
+      }
+    }
+
+    bool insert_or_assign(const Key& key, const Value& value, std::uint64_t hash) {
+      std::lock_guard lock{mutex_};
+      if (const auto index = find_locked(key, hash); index != npos()) {
+        write([&] { table().slots[index].value.store(value); });
+        return false;
+      }
+      insert_locked(key, value, hash);
+      return true;
+    }
+
+    bool erase(const Key& key, std::uint64_t hash) {
+      std::lock_guard lock{mutex_};
+      const auto index = find_locked(key, hash);
+      if (index == npos()) return false;
+
+      write([&] { table().slots[index].meta.store(k_deleted, std::memory_order_relaxed); });
+      ++deleted_;
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    template <typename F>
+    Value compute_if_absent(const Key& key, std::uint64_t hash, F& make) {
+      if (auto found = get(key, hash)) {
+        return *found;
+      }
+
+      std::lock_guard lock{mutex_};
+      if (const auto index = find_locked(key, hash); index != npos()) {
+        return table().slots[index].value.load();
+      }
+      Value value = make();
+      insert_locked(key, value, hash);
+      return value;
+    }
+
+   private:
+    static constexpr auto npos() noexcept -> std::size_t { return ~std::size_t{0}; }
+
+    auto table() const noexcept -> Table& { return *tables_.back(); }
+
+    /// bounded by the capacity: a torn snapshot may have no empty slot in sight.
+    static std::optional<Value> probe(const Table& table, const Key& key, std::uint64_t hash) noexcept {
+      const auto mask = table.capacity - 1;
+      const auto meta = full_meta(hash);
+      auto index = home_of(full_meta(hash), mask);
+      for (std::size_t step = 0; step < table.capacity; ++step, index = (index + 1) & mask) {
+        const auto& slot = table.slots[index];
+        const auto current = slot.meta.load(std::memory_order_relaxed);
+        if (current == k_empty) break;
+        if (current == meta && KeyEqual{}(slot.key.load(), key)) {
+          return slot.value.load();
+        }
+      }
+      return std::nullopt;
+    }
+
+    auto find_locked(const Key& key, std::uint64_t hash) const noexcept -> std::size_t {
+      const auto& current = table();
+      const auto mask = current.capacity - 1;
+      const auto meta = full_meta(hash);
+      auto index = home_of(full_meta(hash), mask);
+      for (std::size_t step = 0; step < current.capacity; ++step, index = (index + 1) & mask) {
+        const auto& slot = current.slots[index];
+        const auto state = slot.meta.load(std::memory_order_relaxed);
+        if (state == k_empty) break;
+        if (state == meta && KeyEqual{}(slot.key.load(), key)) return index;
+      }
+      return npos();
+    }
+
+    /// one seqlock write section: readers overlapping it retry.
+    template <typename F>
+    void write(F&& f) noexcept {
+      const auto version = version_.load(std::memory_order_relaxed);
+      version_.store(version + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      f();
+      version_.store(version + 2, std::memory_order_release);
+    }
+
+    void insert_locked(const Key& key, const Value& value, std::uint64_t hash) {
+      const auto size = size_.load(std::memory_order_relaxed);
+      if ((size + deleted_ + 1) * 4 > table().capacity * 3) {
+        if ((size + 1) * 2 > table().capacity) grow();
+        else purge();
+      }
+
+      auto& current = table();
+      const auto mask = current.capacity - 1;
+      auto index = home_of(full_meta(hash), mask);
+      while (current.slots[index].meta.load(std::memory_order_relaxed) > k_deleted) {
+        index = (index + 1) & mask;
+      }
+
+      auto& slot = current.slots[index];
+      if (slot.meta.load(std::memory_order_relaxed) == k_deleted) {
+        --deleted_;
+      }
+      write([&] {
+        slot.key.store(key);
+        slot.value.store(value);
+        slot.meta.store(full_meta(hash), std::memory_order_relaxed);
+      });
+      size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void place(Table& table, std::uint64_t meta, const Key& key, const Value& value) noexcept {
+      const auto mask = table.capacity - 1;
+      auto index = home_of(meta, mask);
+      while (table.slots[index].meta.load(std::memory_order_relaxed) != k_empty) {
+        index = (index + 1) & mask;
+      }
+      auto& slot = table.slots[index];
+      slot.key.store(key);
+      slot.value.store(value);
+      slot.meta.store(meta, std::memory_order_relaxed);
+    }
+
+    /// fills a table twice as large aside, then publishes it; the old one stays readable.
+    void grow() {
+      auto& current = table();
+      auto next = std::make_unique<Table>(current.capacity * 2);
+      for (std::size_t i = 0; i < current.capacity; ++i) {
+        const auto& slot = current.slots[i];
+        const auto meta = slot.meta.load(std::memory_order_relaxed);
+        if (meta > k_deleted) {
+          place(*next, meta, slot.key.load(), slot.value.load());
+        }
+      }
+
+      tables_.push_back(std::move(next));
+      deleted_ = 0;
+      // release: a reader reaching the new table also sees it filled.
+      write([&] { table_.store(tables_.back().get(), std::memory_order_release); });
+    }
+
+    /// drops the tombstones in place (readers retry meanwhile), so churn retires no table.
+    void purge() {
+      struct Live {
+        std::uint64_t meta;
+        Key key;
+        Value value;
+      };
+
+      auto& current = table();
+      std::vector<Live> live;
+      live.reserve(size_.load(std::memory_order_relaxed));
+      for (std::size_t i = 0; i < current.capacity; ++i) {
+        const auto& slot = current.slots[i];
+        const auto meta = slot.meta.load(std::memory_order_relaxed);
+        if (meta > k_deleted) {
+          live.push_back({meta, slot.key.load(), slot.value.load()});
+        }
+      }
+
+      write([&] {
+        for (std::size_t i = 0; i < current.capacity; ++i) {
+          current.slots[i].meta.store(k_empty, std::memory_order_relaxed);
+        }
+        for (const auto& entry : live) {
+          place(current, entry.meta, entry.key, entry.value);
+        }
+      });
+      deleted_ = 0;
+    }
+  };
+
+  /// fallback shard for types a reader can't copy racily: reads lock too.
+  class LockedShard {
+    alignas(64) mutable SpinMutex mutex_;
+    FlatHashMap<Key, Value, Hash, KeyEqual> map_;
+    std::atomic<std::size_t> size_{0};
+
+   public:
+    [[nodiscard]] auto size() const noexcept -> std::size_t { return size_.load(std::memory_order_relaxed); }
+
+    std::optional<Value> get(const Key& key, std::uint64_t) const {
+      std::lock_guard lock{mutex_};
+      if (const auto* value = map_.at(key)) {
+        return *value;
+      }
+      return std::nullopt;
+    }
+
+    bool insert_or_assign(const Key& key, const Value& value, std::uint64_t) {
+      std::lock_guard lock{mutex_};
+      if (auto* current = map_.at(key)) {
+        *current = value;
+        return false;
+      }
+      map_.insert(key, value);
+      size_.store(map_.size(), std::memory_order_relaxed);
+      return true;
+    }
+
+    bool erase(const Key& key, std::uint64_t) {
+      std::lock_guard lock{mutex_};
+      const bool erased = map_.remove(key);
+      size_.store(map_.size(), std::memory_order_relaxed);
+      return erased;
+    }
+
+    template <typename F>
+    Value compute_if_absent(const Key& key, std::uint64_t, F& make) {
+      std::lock_guard lock{mutex_};
+      if (const auto* value = map_.at(key)) {
+        return *value;
+      }
+      Value value = make();
+      map_.insert(key, value);
+      size_.store(map_.size(), std::memory_order_relaxed);
+      return value;
+    }
+  };
+
+  using shard_type = std::conditional_t<optimistic_reads, OptimisticShard, LockedShard>;
+
+  std::unique_ptr<shard_type[]> shards_;
+
+ public:
+  ConcurrentHashMap() : shards_(std::make_unique<shard_type[]>(Shards)) {}
+
+  ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+  ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+  /// @return a copy of the value, or nullopt.
+  std::optional<Value> get(const Key& key) const {
+    const auto hash = hash_of(key);
+    return shard_of(hash).get(key, hash);
+  }
+
+  bool contains(const Key& key) const { return get(key).has_value(); }
+
+  /// @return true if `key` was added, false if its value was replaced.
+  bool insert_or_assign(const Key& key, const Value& value) {
+    const auto hash = hash_of(key);
+    return shard_of(hash).insert_or_assign(key, value, hash);
+  }
+
+  /// @return false if `key` wasn't there.
+  bool erase(const Key& key) {
+    const auto hash = hash_of(key);
+    return shard_of(hash).erase(key, hash);
+  }
+
+  /**
+   * @return the value of `key`, inserting `make()` first if it's absent.
+   * `make` runs under the shard lock, at most once per absent key; if it throws, nothing is inserted.
+   */
+  template <typename F>
+  Value compute_if_absent(const Key& key, F&& make) {
+    const auto hash = hash_of(key);
+    return shard_of(hash).compute_if_absent(key, hash, make);
+  }
+
+  /// sum of the shard sizes; only a hint while writers run.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < Shards; ++i) {
+      total += shards_[i].size();
+    }
+    return total;
+  }
+
+ private:
+  /// splitmix64 finalizer: the top bits pick the shard, the low ones the slot.
+  static auto hash_of(const Key& key) noexcept(noexcept(Hash{}(key))) -> std::uint64_t {
+    auto hash = static_cast<std::uint64_t>(Hash{}(key));
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+  }
+
+  auto shard_of(std::uint64_t hash) const noexcept -> shard_type& {
+    const auto index = k_shard_bits == 0 ? 0 : static_cast<std::size_t>(hash >> (64 - k_shard_bits));
+    return shards_[index];
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_CONCURRENT_HASH_MAP_HPP_
@@ -0,0 +1,20 @@
+#ifndef TOYPP_THREADED_CPU_RELAX_HPP_
+#define TOYPP_THREADED_CPU_RELAX_HPP_
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define TOYPP_CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define TOYPP_CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define TOYPP_CPU_RELAX() ((void)0)
+#endif
+
+namespace tpp {
+
+/// hints the cpu that we're in a spin-wait loop (`pause` on x86, `yield` on arm).
+inline void cpu_relax() noexcept { TOYPP_CPU_RELAX(); }
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_CPU_RELAX_HPP_
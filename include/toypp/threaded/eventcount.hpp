@@ -0,0 +1,104 @@
+#ifndef TOYPP_THREADED_EVENTCOUNT_HPP_
+#define TOYPP_THREADED_EVENTCOUNT_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "toypp/threaded/cpu_relax.hpp"
+#include "toypp/threaded/futex.hpp"
+
+namespace tpp {
+
+/**
+ * Eventcount: lets a lock-free structure block its consumers on "not empty"
+ * without a mutex, and without a syscall on the producer side when nobody waits.
+ *
+ * Consumer:
+ *   while (!try_pop(item)) {
+ *     auto key = events.prepare_wait();
+ *     if (try_pop(item)) { events.cancel_wait(); break; }
+ *     events.commit_wait(key);
+ *   }
+ * Producer: push, then `notify_one()` / `notify_all()`.
+ *
+ * A notification between `prepare_wait` and `commit_wait` is never lost:
+ * it bumps the epoch, and `commit_wait` returns as soon as the epoch moved.
+ * `commit_wait` spins `SpinCount` times before parking on the epoch futex.
+ */
+template <std::size_t SpinCount = 128>
+class BasicEventCount {
+  alignas(64) std::atomic<std::uint32_t> epoch_{0};
+  std::atomic<std::uint32_t> waiters_{0};
+
+ public:
+  using key_type = std::uint32_t;
+
+  BasicEventCount() {}
+  BasicEventCount(const BasicEventCount&) = delete;
+  BasicEventCount& operator=(const BasicEventCount&) = delete;
+
+  /// announces a wait; the caller must re-check its condition, then cancel or commit.
+  [[nodiscard]] key_type prepare_wait() noexcept {
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_seq_cst);
+  }
+
+  void cancel_wait() noexcept { waiters_.fetch_sub(1, std::memory_order_relaxed); }
+
+  /// blocks until a notification that came after `prepare_wait` (or spuriously).
+  void commit_wait(key_type key) noexcept {
+    for (std::size_t spin = 0; spin < SpinCount; ++spin) {
+      if (epoch_.load(std::memory_order_acquire) != key) {
+        cancel_wait();
+        return;
+      }
+      cpu_relax();
+    }
+    while (epoch_.load(std::memory_order_acquire) == key) {
+      futex_wait(epoch_, key);
+    }
+    cancel_wait();
+  }
+
+  /// blocks until `ready()` returns true; `ready` must be safe to call concurrently with producers.
+  template <typename Pred>
+  void await(Pred&& ready) noexcept(noexcept(ready())) {
+    while (!ready()) {
+      const auto key = prepare_wait();
+      if (ready()) {
+        cancel_wait();
+        return;
+      }
+      commit_wait(key);
+    }
+  }
+
+  void notify_one() noexcept {
+    if (has_waiters()) {
+      epoch_.fetch_add(1, std::memory_order_release);
+      futex_wake_one(epoch_);
+    }
+  }
+
+  void notify_all() noexcept {
+    if (has_waiters()) {
+      epoch_.fetch_add(1, std::memory_order_release);
+      futex_wake_all(epoch_);
+    }
+  }
+
+ private:
+  bool has_waiters() const noexcept {
+    // pairs with `prepare_wait`: either the waiter's re-check sees our update,
+    // or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return waiters_.load(std::memory_order_relaxed) != 0;
+  }
+};
+
+using EventCount = BasicEventCount<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_EVENTCOUNT_HPP_
@@ -0,0 +1,83 @@
+#ifndef TOYPP_THREADED_FUTEX_HPP_
+#define TOYPP_THREADED_FUTEX_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tpp {
+
+/**
+ * Thin wrappers over linux futex(2) on a 32-bit atomic word.
+ *
+ * `futex_wait` sleeps only while `word == expected` and may return spuriously,
+ * so callers always re-check their condition in a loop.
+ * On other platforms waiting degrades to yielding/sleeping.
+ */
+
+inline void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+  if (word.load(std::memory_order_relaxed) == expected) {
+    std::this_thread::yield();
+  }
+#endif
+}
+
+/// @return false if timed out.
+inline bool futex_wait_for(std::atomic<std::uint32_t>& word,
+                           std::uint32_t expected,
+                           std::chrono::nanoseconds timeout) noexcept {
+  if (timeout <= std::chrono::nanoseconds::zero()) {
+    return false;
+  }
+#if defined(__linux__)
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+  ::timespec ts{};
+  ts.tv_sec = static_cast<decltype(ts.tv_sec)>(seconds.count());
+  ts.tv_nsec = static_cast<decltype(ts.tv_nsec)>((timeout - seconds).count());
+  const auto res = ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+                             FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+  return !(res == -1 && errno == ETIMEDOUT);
+#else
+  if (word.load(std::memory_order_relaxed) == expected) {
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(50)));
+  }
+  return true;
+#endif
+}
+
+inline void futex_wake_one(std::atomic<std::uint32_t>& word) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+inline void futex_wake_all(std::atomic<std::uint32_t>& word) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+            FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_FUTEX_HPP_
@@ -0,0 +1,54 @@
+#ifndef TOYPP_THREADED_LATCH_HPP_
+#define TOYPP_THREADED_LATCH_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+#include "toypp/threaded/wait_strategy.hpp"
+
+namespace tpp {
+
+/**
+ * Single-use countdown: `wait` returns once the counter reached zero.
+ *
+ * Like `std::latch`. With the default `FutexWait`, waiters spin for a while
+ * and then park; counting down only makes a syscall on the last arrival,
+ * and only if someone is parked.
+ *
+ * @tparam WaitStrategy see wait_strategy.hpp.
+ */
+template <typename WaitStrategy = FutexWait>
+class BasicLatch {
+  std::atomic<std::uint32_t> count_;
+  WaitStrategy wait_;
+
+ public:
+  explicit BasicLatch(std::uint32_t count) noexcept : count_(count) {}
+  BasicLatch(const BasicLatch&) = delete;
+  BasicLatch& operator=(const BasicLatch&) = delete;
+
+  void count_down(std::uint32_t n = 1) noexcept {
+    if (count_.fetch_sub(n, std::memory_order_acq_rel) == n) {
+      wait_.notify();
+    }
+  }
+
+  [[nodiscard]] bool try_wait() const noexcept {
+    return count_.load(std::memory_order_acquire) == 0;
+  }
+
+  void wait() noexcept {
+    wait_.wait_until([this] { return try_wait(); });
+  }
+
+  void arrive_and_wait(std::uint32_t n = 1) noexcept {
+    count_down(n);
+    wait();
+  }
+};
+
+using Latch = BasicLatch<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_LATCH_HPP_
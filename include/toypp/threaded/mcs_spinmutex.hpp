@@ -0,0 +1,119 @@
+#ifndef TOYPP_THREADED_MCS_SPINMUTEX_HPP_
+#define TOYPP_THREADED_MCS_SPINMUTEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "toypp/threaded/cpu_relax.hpp"
+
+namespace tpp {
+
+/**
+ * MCS queue lock: FIFO-fair, and every waiter spins on its own cache line.
+ *
+ * Each `lock` enqueues a node with a single exchange on the tail; the owner
+ * hands the lock over by clearing its successor's flag, so under contention
+ * a release touches exactly one other core.
+ *
+ * Nodes come from a thread-local free list, which keeps the plain
+ * Lockable interface (`std::lock_guard` and co.) of SpinMutex.
+ */
+class MCSSpinMutex {
+  struct alignas(64) Node {
+    std::atomic<Node*> next{nullptr};
+    std::atomic<bool> locked{false};
+    Node* free_next = nullptr;
+  };
+
+  struct NodePool {
+    Node* free = nullptr;
+
+    ~NodePool() {
+      while (free) {
+        delete std::exchange(free, free->free_next);
+      }
+    }
+  };
+
+  static constexpr std::uint32_t k_spin_count = 1024;
+
+  alignas(64) std::atomic<Node*> tail_{nullptr};
+  alignas(64) Node* owner_ = nullptr;
+
+ public:
+  MCSSpinMutex() {}
+  MCSSpinMutex(const MCSSpinMutex&) = delete;
+
+  void lock() {
+    auto* node = acquire_node();
+
+    auto* prev = tail_.exchange(node, std::memory_order_acq_rel);
+    if (prev) {
+      prev->next.store(node, std::memory_order_release);
+      for (std::uint32_t spin = 0; node->locked.load(std::memory_order_acquire); ++spin) {
+        if (spin < k_spin_count)
+          cpu_relax();
+        else
+          std::this_thread::yield();
+      }
+    }
+
+    owner_ = node;
+  }
+
+  bool try_lock() {
+    auto* node = acquire_node();
+    Node* expected = nullptr;
+    if (!tail_.compare_exchange_strong(expected, node, std::memory_order_acquire, std::memory_order_relaxed)) {
+      release_node(node);
+      return false;
+    }
+    owner_ = node;
+    return true;
+  }
+
+  void unlock() noexcept {
+    auto* node = owner_;
+    auto* next = node->next.load(std::memory_order_acquire);
+
+    if (!next) {
+      auto* expected = node;
+      if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed)) {
+        release_node(node);
+        return;
+      }
+      // a successor swapped the tail, but hasn't linked itself yet.
+      while (!(next = node->next.load(std::memory_order_acquire)))
+        cpu_relax();
+    }
+
+    next->locked.store(false, std::memory_order_release);
+    release_node(node);
+  }
+
+ private:
+  static NodePool& node_pool() noexcept {
+    thread_local NodePool pool;
+    return pool;
+  }
+
+  static Node* acquire_node() {
+    auto& pool = node_pool();
+    Node* node = pool.free ? std::exchange(pool.free, pool.free->free_next) : new Node;
+    node->next.store(nullptr, std::memory_order_relaxed);
+    node->locked.store(true, std::memory_order_relaxed);
+    return node;
+  }
+
+  static void release_node(Node* node) noexcept {
+    auto& pool = node_pool();
+    node->free_next = pool.free;
+    pool.free = node;
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_MCS_SPINMUTEX_HPP_
@@ -0,0 +1,190 @@
+#ifndef TOYPP_THREADED_MPSC_RINGBUFFER_HPP_
+#define TOYPP_THREADED_MPSC_RINGBUFFER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "toypp/span.hpp"
+#include "toypp/threaded/cpu_relax.hpp"
+
+namespace tpp {
+
+/**
+ * Thread-Safe multi-producer-single-consumer ring buffer of byte records.
+ *
+ * `write` can be used by any number of threads simultanously: each producer
+ * claims its space with a single `fetch_add` on the reservation cursor, copies
+ * its bytes, then commits by publishing the record header.
+ * `read` (consumer) can be used by only one thread at a time, and sees only
+ * committed records, in claim order.
+ *
+ * A record never splits at the wrap point: a claim that straddles the end is
+ * turned into padding, and the producer claims again.
+ * Producers block (spin, then yield) while the ring is full.
+ */
+class MPSCRingBuffer {
+  using header_type = std::uint32_t;
+  using atomic_header_type = std::atomic<header_type>;
+
+  static_assert(sizeof(atomic_header_type) == sizeof(header_type)
+                && atomic_header_type::is_always_lock_free,
+                "record headers are atomics placed inside the byte buffer.");
+
+  static constexpr std::size_t k_alignment = alignof(std::uint64_t);
+  static constexpr header_type k_padding_bit = header_type{1} << 31;
+  static constexpr std::size_t k_spin_count = 64;
+
+  std::size_t capacity_ = 0;
+  std::size_t mask_ = 0;
+  std::unique_ptr<std::uint64_t[]> buffer_;
+
+  alignas(64) std::atomic<std::uint64_t> reserve_{0};
+  alignas(64) std::atomic<std::uint64_t> head_{0};
+
+ public:
+  /// `size` is rounded up to a power of two.
+  explicit MPSCRingBuffer(std::size_t size)
+    : capacity_(round_up_capacity(size))
+    , mask_(capacity_ - 1)
+    , buffer_(std::make_unique<std::uint64_t[]>(capacity_ / sizeof(std::uint64_t)))
+  {}
+  MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+  MPSCRingBuffer(MPSCRingBuffer&&) noexcept = delete;
+  MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+  MPSCRingBuffer& operator=(MPSCRingBuffer&&) noexcept = delete;
+  ~MPSCRingBuffer() = default;
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  /**
+   * Largest record `write` accepts: half the ring, so a retried claim can't
+   * straddle forever, and below `k_padding_bit` once aligned, so the 32-bit
+   * header never reads as padding.
+   */
+  [[nodiscard]] auto max_message_size() const noexcept -> std::size_t {
+    constexpr std::size_t header_limit = k_padding_bit - sizeof(header_type) - k_alignment;
+    return std::min(capacity_ / 2 - sizeof(header_type), header_limit);
+  }
+
+  /**
+   * Copies `size` bytes as one record, blocking while the ring is full.
+   *
+   * @return false if the record can never fit.
+   */
+  auto write(const char* ptr, std::size_t size) -> bool
+  {
+    if (size > max_message_size()) {
+      return false;
+    }
+
+    const auto record_size = record_size_of(size);
+    while (true) {
+      const auto position = reserve_.fetch_add(record_size, std::memory_order_relaxed);
+      wait_for_room(position + record_size);
+
+      const auto offset = static_cast<std::size_t>(position & mask_);
+      if (offset + record_size > capacity_) {
+        // straddles the end: give both pieces back as padding and claim again.
+        const auto first_piece = capacity_ - offset;
+        header_at(0).store(k_padding_bit | static_cast<header_type>(record_size - first_piece),
+                           std::memory_order_release);
+        header_at(offset).store(k_padding_bit | static_cast<header_type>(first_piece),
+                                std::memory_order_release);
+        continue;
+      }
+
+      std::memcpy(bytes() + offset + sizeof(header_type), ptr, size);
+      header_at(offset).store(static_cast<header_type>(size + 1), std::memory_order_release);
+      return true;
+    }
+  }
+
+  /**
+   * Hands every committed record, in order, to `visitor(Span<const char>)`,
+   * then gives their space back to the producers.
+   *
+   * The span is valid only during the call.
+   *
+   * @return number of records read.
+   */
+  template <typename F>
+  auto read(F&& visitor) -> std::size_t
+  {
+    const auto start = head_.load(std::memory_order_relaxed);
+    auto head = start;
+    std::size_t count = 0;
+
+    while (head - start < capacity_) {
+      const auto offset = static_cast<std::size_t>(head & mask_);
+      const auto header = header_at(offset).load(std::memory_order_acquire);
+      if (header == 0) {
+        break;
+      }
+
+      std::size_t region_size = 0;
+      if (header & k_padding_bit) {
+        region_size = header & ~k_padding_bit;
+      } else {
+        const std::size_t length = header - 1;
+        visitor(Span<const char>(bytes() + offset + sizeof(header_type), length));
+        region_size = record_size_of(length);
+        ++count;
+      }
+
+      // producers expect a zeroed region, so a stale header never looks committed.
+      std::memset(bytes() + offset, 0, region_size);
+      head += region_size;
+    }
+
+    if (head != start) {
+      head_.store(head, std::memory_order_release);
+    }
+    return count;
+  }
+
+ private:
+  static constexpr auto record_size_of(std::size_t length) noexcept -> std::size_t
+  {
+    const auto size = sizeof(header_type) + length;
+    return (size + k_alignment - 1) / k_alignment * k_alignment;
+  }
+
+  static constexpr auto round_up_capacity(std::size_t size) noexcept -> std::size_t
+  {
+    std::size_t capacity = 64;
+    while (capacity < size) {
+      capacity <<= 1;
+    }
+    return capacity;
+  }
+
+  [[nodiscard]] auto bytes() const noexcept -> char*
+  {
+    return reinterpret_cast<char*>(buffer_.get());
+  }
+
+  [[nodiscard]] auto header_at(std::size_t offset) const noexcept -> atomic_header_type&
+  {
+    return *reinterpret_cast<atomic_header_type*>(bytes() + offset);
+  }
+
+  void wait_for_room(std::uint64_t claim_end) const noexcept
+  {
+    for (std::size_t spin = 0; claim_end - head_.load(std::memory_order_acquire) > capacity_; ++spin) {
+      if (spin < k_spin_count) {
+        cpu_relax();
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_MPSC_RINGBUFFER_HPP_
@@ -0,0 +1,267 @@
+#ifndef TOYPP_THREADED_PERSISTENT_RINGBUFFER_HPP_
+#define TOYPP_THREADED_PERSISTENT_RINGBUFFER_HPP_
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "toypp/threaded/spsc_ringbuffer.hpp"
+
+namespace tpp {
+
+/**
+ * `BasicSPSCRingBuffer` storage backed by a `mmap`ed file (POSIX only).
+ *
+ * File layout: one header page holding the magic, the capacity and both
+ * cursors, followed by the ring bytes. Since the producer moves `tail` only
+ * after the record is in place, the file is consistent whenever the process
+ * dies: the page cache keeps everything that was published. The magic is
+ * written last, so a file whose magic is still zero (a crash right after it
+ * was sized) is initialized again on open.
+ *
+ * To survive a power loss as well, pages must reach the disk: `sync()` does
+ * that explicitly, and a non-zero `sync_every` batches it every N publishes.
+ */
+class MappedFileRingStorage {
+  static constexpr char k_magic[8] = {'t', 'p', 'p', 'r', 'i', 'n', 'g', '\0'};
+  static constexpr std::uint32_t k_version = 1;
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t size;
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+  };
+
+  int fd_ = -1;
+  std::size_t header_size_ = 0;
+  std::size_t mapping_size_ = 0;
+  void* mapping_ = nullptr;
+  Header* header_ = nullptr;
+  std::size_t sync_every_ = 0;
+  std::size_t unsynced_writes_ = 0;
+
+ public:
+  /**
+   * Opens (and recovers) the ring at `path`, or creates it with `size` bytes.
+   *
+   * @param size ignored when the file already exists.
+   * @throw std::invalid_argument when creating a ring under 2 bytes.
+   * @param sync_every `msync` after every N publishes; 0 only syncs on `sync()` and close.
+   */
+  MappedFileRingStorage(const std::string& path, std::size_t size, std::size_t sync_every = 0)
+    : sync_every_(sync_every)
+  {
+    static_assert(std::atomic<std::size_t>::is_always_lock_free,
+                  "cursors are shared through the file, they must be lock-free.");
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ == -1) {
+      throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+
+    struct ::stat st{};
+    if (::fstat(fd_, &st) == -1) {
+      close_file();
+      throw std::system_error(errno, std::generic_category(), "fstat " + path);
+    }
+
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    header_size_ = (sizeof(Header) + page_size - 1) / page_size * page_size;
+
+    const bool created = (st.st_size == 0);
+    if (created) {
+      if (size < 2) {
+        close_file();
+        ::unlink(path.c_str());
+        throw std::invalid_argument("tpp::MappedFileRingStorage: the ring needs at least 2 bytes.");
+      }
+      mapping_size_ = header_size_ + size;
+      if (::ftruncate(fd_, static_cast<::off_t>(mapping_size_)) == -1) {
+        close_file();
+        throw std::system_error(errno, std::generic_category(), "ftruncate " + path);
+      }
+    } else {
+      mapping_size_ = static_cast<std::size_t>(st.st_size);
+      if (mapping_size_ < header_size_) {
+        close_file();
+        throw std::runtime_error("not a ring buffer file: " + path);
+      }
+    }
+
+    mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping_ == MAP_FAILED) {
+      mapping_ = nullptr;
+      close_file();
+      throw std::system_error(errno, std::generic_category(), "mmap " + path);
+    }
+
+    header_ = std::launder(static_cast<Header*>(mapping_));
+    if (created || is_uninitialized()) {
+      if (mapping_size_ < header_size_ + 2) {
+        unmap_and_close();
+        throw std::runtime_error("not a ring buffer file: " + path);
+      }
+      initialize(mapping_size_ - header_size_);
+    } else if (!is_valid_header()) {
+      unmap_and_close();
+      throw std::runtime_error("corrupted ring buffer header: " + path);
+    }
+  }
+
+  MappedFileRingStorage(const MappedFileRingStorage&) = delete;
+  MappedFileRingStorage& operator=(const MappedFileRingStorage&) = delete;
+
+  ~MappedFileRingStorage() {
+    sync();
+    unmap_and_close();
+  }
+
+  [[nodiscard]] auto data() noexcept -> char* { return static_cast<char*>(mapping_) + header_size_; }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return static_cast<std::size_t>(header_->size); }
+  [[nodiscard]] auto head() noexcept -> std::atomic<std::size_t>& { return header_->head; }
+  [[nodiscard]] auto tail() noexcept -> std::atomic<std::size_t>& { return header_->tail; }
+
+  void on_write() noexcept {
+    if (sync_every_ != 0 && ++unsynced_writes_ >= sync_every_) {
+      sync();
+    }
+  }
+
+  void on_read() noexcept {}
+
+  /// flushes the header and the ring bytes to disk.
+  void sync() noexcept {
+    unsynced_writes_ = 0;
+    if (mapping_) {
+      ::msync(mapping_, mapping_size_, MS_SYNC);
+    }
+  }
+
+ private:
+  /// the magic goes last: until it's synced, the file reads as uninitialized.
+  void initialize(std::size_t size) noexcept {
+    header_ = new (mapping_) Header{};
+    header_->version = k_version;
+    header_->size = size;
+    sync();
+    std::memcpy(header_->magic, k_magic, sizeof(k_magic));
+    sync();
+  }
+
+  [[nodiscard]] bool is_uninitialized() const noexcept {
+    constexpr char zeros[sizeof(k_magic)] = {};
+    return std::memcmp(header_->magic, zeros, sizeof(zeros)) == 0;
+  }
+
+  [[nodiscard]] bool is_valid_header() const noexcept {
+    const auto ring_size = header_->size;
+    const auto head = header_->head.load(std::memory_order_relaxed);
+    const auto tail = header_->tail.load(std::memory_order_relaxed);
+    return std::memcmp(header_->magic, k_magic, sizeof(k_magic)) == 0
+        && header_->version == k_version
+        && ring_size >= 2
+        && header_size_ + ring_size <= mapping_size_
+        && head < ring_size
+        && tail < ring_size;
+  }
+
+  void close_file() noexcept {
+    if (fd_ != -1) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  void unmap_and_close() noexcept {
+    if (mapping_) {
+      ::munmap(mapping_, mapping_size_);
+      mapping_ = nullptr;
+      header_ = nullptr;
+    }
+    close_file();
+  }
+};
+
+/**
+ * A crash-safe spool: `BasicSPSCRingBuffer` whose bytes and cursors live in a file.
+ *
+ * Reopening the file resumes exactly where the consumer and the producer were,
+ * so whatever was published and not yet released is replayed.
+ * On open, both cursors are clamped onto the record grid, the records
+ * between head and tail are walked, and the tail is cut back to the last
+ * well-formed record (only possible if pages were lost, e.g. power loss
+ * without `sync`). Meant for the framed mode.
+ */
+template <typename WaitStrategy = BusySpinWait>
+class BasicPersistentSPSCRingBuffer
+  : public BasicSPSCRingBuffer<WaitStrategy, MappedFileRingStorage> {
+  using base_type = BasicSPSCRingBuffer<WaitStrategy, MappedFileRingStorage>;
+
+ public:
+  /// see `MappedFileRingStorage`.
+  BasicPersistentSPSCRingBuffer(const std::string& path, std::size_t size, std::size_t sync_every = 0)
+    : base_type(std::in_place, path, size, sync_every)
+  {
+    recover();
+  }
+
+  void sync() noexcept { this->storage().sync(); }
+
+ private:
+  void recover() noexcept {
+    auto& storage = this->storage();
+    const auto ring_size = this->framed_size();
+    if (ring_size == 0) {
+      return;
+    }
+    const auto stored_head = storage.head().load(std::memory_order_relaxed);
+    const auto stored_tail = storage.tail().load(std::memory_order_relaxed);
+    const auto head = clamp_cursor(stored_head);
+    const auto tail = clamp_cursor(stored_tail);
+
+    auto position = head;
+    while (position != tail) {
+      const auto length = this->load_header(position);
+      const auto room = (position < tail) ? (tail - position) : (ring_size - position);
+      if (length == base_type::k_skip_marker) {
+        if (position < tail) break;
+        position = 0;
+        continue;
+      }
+      if (this->record_size_of(length) > room) break;
+      position = (position + this->record_size_of(length)) % ring_size;
+    }
+
+    if (head != stored_head || position != stored_tail) {
+      storage.head().store(head, std::memory_order_relaxed);
+      storage.tail().store(position, std::memory_order_relaxed);
+      storage.sync();
+    }
+  }
+
+  /// aligned down, and past the framed end means wrapped to 0.
+  [[nodiscard]] auto clamp_cursor(std::size_t cursor) const noexcept -> std::size_t {
+    cursor = cursor / base_type::k_message_alignment * base_type::k_message_alignment;
+    return cursor < this->framed_size() ? cursor : 0;
+  }
+};
+
+using PersistentSPSCRingBuffer = BasicPersistentSPSCRingBuffer<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_PERSISTENT_RINGBUFFER_HPP_
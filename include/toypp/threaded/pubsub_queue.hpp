@@ -1,51 +1,315 @@
 #ifndef TOYPP_THREADED_PUBSUB_QUEUE_HPP_
 #define TOYPP_THREADED_PUBSUB_QUEUE_HPP_
 
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <thread>
 #include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "toypp/threaded/cpu_relax.hpp"
 
 namespace tpp {
 
+/**
+ * What a `PubSubQueue` publisher does when a subscription is a full ring behind.
+ */
+enum class LagPolicy {
+  block,        ///< wait for it to catch up; nothing is ever lost.
+  drop_oldest,  ///< skip its oldest unread messages; it's told through `gap()`.
+  disconnect,   ///< drop the subscription; it reads nothing more, see `connected()`.
+};
+
+/**
+ * Broadcast queue: every subscription sees every message published after it subscribed.
+ *
+ * Disruptor-style ring: publishers claim a sequence number with one `fetch_add`
+ * on the claim cursor, write the slot in place, and stamp it with its sequence.
+ * Each subscription only owns a cursor (its next sequence) and reads slots
+ * without any lock; nothing is allocated per message.
+ *
+ * A publisher can't overwrite a slot that some subscription hasn't read yet;
+ * the `LagPolicy` decides what happens to that subscription. The slowest
+ * cursor is cached, so the registry mutex is only taken when the cache is too
+ * old, and on subscribe/unsubscribe. Memory is bounded by the ring whatever
+ * the policy.
+ *
+ * The default policy, `LagPolicy::block`, makes `publish` block: one idle
+ * subscription stalls every publisher once it is `capacity` messages behind.
+ * (The previous, unbounded queue never blocked `publish`.) Pick `drop_oldest`
+ * or `disconnect` when publishers must never wait on subscribers.
+ *
+ * Messages are read in place: `visit` and `peek` hand out const references,
+ * so a large payload isn't copied once per subscriber, and move-only types
+ * work (only `dequeue` copies). With `drop_oldest` and `disconnect`, a
+ * subscription flags its cursor busy while it reads, and publishers move
+ * cursors with a CAS, so a slot is never overwritten under a reader.
+ *
+ * Subscriptions must not outlive the queue.
+ */
 template <typename T>
 class PubSubQueue {
+ public:
   using value_type = std::remove_cv_t<std::remove_reference_t<T>>;
 
-  static_assert(
-    std::is_copy_assignable_v<value_type>,
-    "type must be copyable so multiple subscribers read the same value."
-  );
+ private:
+  static constexpr std::size_t k_spin_count = 64;
+
+  // cursor flags, above any reachable sequence.
+  static constexpr std::uint64_t k_busy = std::uint64_t{1} << 63;
+  static constexpr std::uint64_t k_disconnected = std::uint64_t{1} << 62;
+  static constexpr std::uint64_t k_sequence_mask = k_disconnected - 1;
 
-  struct Node {
+  struct Slot {
+    /// sequence + 1 of the message it holds, 0 if none yet.
+    std::atomic<std::uint64_t> published{0};
     std::optional<value_type> value;
-    std::shared_ptr<Node> next{};
   };
 
-  std::shared_mutex _mutex;
-  std::shared_ptr<Node> _tail;
+  struct alignas(64) Cursor {
+    std::atomic<std::uint64_t> sequence{0};
+  };
+
+  std::size_t _capacity = 0;
+  std::size_t _mask = 0;
+  LagPolicy _policy = LagPolicy::block;
+  std::unique_ptr<Slot[]> _slots;
+
+  alignas(64) std::atomic<std::uint64_t> _claim{0};
+  alignas(64) std::atomic<std::uint64_t> _gating_cache{0};
+
+  std::mutex _registry_mutex;
+  std::vector<Cursor*> _cursors;
 
  public:
   class Subscription {
     friend class PubSubQueue;
 
-    std::shared_ptr<Node> _head;
+    PubSubQueue* _owner = nullptr;
+    std::unique_ptr<Cursor> _cursor;
+    std::uint64_t _expected = 0;
+    std::uint64_t _gap = 0;
+    std::uint64_t _dropped = 0;
+    bool _held = false;
 
-    explicit Subscription(std::shared_ptr<Node> node) noexcept : _head(std::move(node)) {}
+    Subscription(PubSubQueue* owner, std::unique_ptr<Cursor> cursor) noexcept
+      : _owner(owner)
+      , _cursor(std::move(cursor))
+      , _expected(_cursor->sequence.load(std::memory_order_relaxed))
+    {}
 
    public:
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    Subscription(Subscription&& other) noexcept
+      : _owner(std::exchange(other._owner, nullptr))
+      , _cursor(std::move(other._cursor))
+      , _expected(other._expected)
+      , _gap(other._gap)
+      , _dropped(other._dropped)
+      , _held(std::exchange(other._held, false))
+    {}
+
+    Subscription& operator=(Subscription&& other) noexcept {
+      if (this != &other) {
+        unsubscribe();
+        _owner = std::exchange(other._owner, nullptr);
+        _cursor = std::move(other._cursor);
+        _expected = other._expected;
+        _gap = other._gap;
+        _dropped = other._dropped;
+        _held = std::exchange(other._held, false);
+      }
+      return *this;
+    }
+
+    ~Subscription() { unsubscribe(); }
+
+    /// copies the next message out.
     std::optional<value_type> dequeue() {
-      auto head_next = std::atomic_load(&_head->next);
-      if (!head_next) {
-        return std::nullopt;
+      static_assert(std::is_copy_constructible_v<value_type>,
+                    "dequeue copies the message, use visit or peek for move-only types.");
+      std::optional<value_type> value;
+      consume([&value](const value_type& message) { value.emplace(message); }, 1);
+      return value;
+    }
+
+    /**
+     * Copies up to `max` messages to `out`, advancing the cursor once for all of them.
+     * @return number of messages copied.
+     */
+    template <typename OutputIt>
+    std::size_t dequeue_batch(OutputIt out, std::size_t max) {
+      return consume([&out](const value_type& message) { *out++ = message; }, max);
+    }
+
+    /**
+     * Hands up to `max` messages to `visitor(const value_type&)`, in place, without copying them.
+     * A throwing visitor leaves its message (and the next ones) unread.
+     * @return number of messages visited.
+     */
+    template <typename F>
+    std::size_t visit(F&& visitor, std::size_t max = 1) {
+      return consume(std::forward<F>(visitor), max);
+    }
+
+    /**
+     * The next message, in place; nullptr if there is none.
+     *
+     * The view stays valid until the subscription advances (`advance`,
+     * `dequeue`, `visit`...). It holds back publishers that need its slot
+     * (whatever the policy), so it should be short-lived, and it must not span
+     * a `publish` on the same queue from the same thread: that can wait on
+     * the peek forever.
+     */
+    const value_type* peek() {
+      if (!hold()) {
+        return nullptr;
+      }
+      return &*_owner->slot_at(held_sequence()).value;
+    }
+
+    /// drops the peeked message.
+    void advance() noexcept {
+      if (_held) {
+        release(held_sequence() + 1);
+      }
+    }
+
+    /// messages dropped (`LagPolicy::drop_oldest`) right before the last message or batch read.
+    [[nodiscard]] auto gap() const noexcept -> std::uint64_t { return _gap; }
+
+    /// messages dropped (`LagPolicy::drop_oldest`) since subscribing.
+    [[nodiscard]] auto dropped() const noexcept -> std::uint64_t { return _dropped; }
+
+    /// false once disconnected for lagging behind (`LagPolicy::disconnect`), or moved from.
+    [[nodiscard]] bool connected() const noexcept {
+      return _owner && !(_cursor->sequence.load(std::memory_order_relaxed) & k_disconnected);
+    }
+
+    /// messages claimed by publishers and not read yet; only a hint under concurrency.
+    [[nodiscard]] auto lag() const noexcept -> std::uint64_t {
+      if (!_owner) {
+        return 0;
+      }
+      const auto sequence = _cursor->sequence.load(std::memory_order_relaxed);
+      if (sequence & k_disconnected) {
+        return 0;
+      }
+      const auto claimed = _owner->_claim.load(std::memory_order_relaxed);
+      const auto position = sequence & k_sequence_mask;
+      return claimed > position ? claimed - position : 0;
+    }
+
+   private:
+    std::uint64_t held_sequence() const noexcept {
+      return _cursor->sequence.load(std::memory_order_relaxed) & k_sequence_mask;
+    }
+
+    /// visits the published messages from the cursor on, then moves the cursor once.
+    template <typename F>
+    std::size_t consume(F&& visitor, std::size_t max) {
+      if (max == 0 || !hold()) {
+        return 0;
+      }
+
+      auto sequence = held_sequence();
+      const auto end = sequence + max;
+      try {
+        // while the cursor is held, publishers can't overwrite anything from it on.
+        do {
+          visitor(*_owner->slot_at(sequence).value);
+          ++sequence;
+        } while (sequence != end && _owner->slot_at(sequence).published.load(std::memory_order_acquire) == sequence + 1);
+      } catch (...) {
+        release(sequence);
+        throw;
+      }
+
+      const auto count = static_cast<std::size_t>(sequence - held_sequence());
+      release(sequence);
+      return count;
+    }
+
+    /**
+     * Makes sure the message at the cursor is published, and that it stays
+     * in place (the cursor is flagged busy with the lossy policies).
+     * @return false if there is no message to read.
+     */
+    bool hold() noexcept {
+      if (_held) {
+        return true;
+      }
+
+      auto sequence = _cursor->sequence.load(std::memory_order_relaxed);
+      if (_owner->_policy == LagPolicy::block) {
+        if (_owner->slot_at(sequence).published.load(std::memory_order_acquire) != sequence + 1) {
+          return false;
+        }
+      } else {
+        while (true) {
+          if (sequence & k_disconnected) {
+            return false;
+          }
+          const auto published = _owner->slot_at(sequence).published.load(std::memory_order_acquire);
+          if (published < sequence + 1) {
+            return false;
+          }
+          if (published > sequence + 1) {
+            // lapped: a publisher moved the cursor past it.
+            sequence = _cursor->sequence.load(std::memory_order_relaxed);
+            continue;
+          }
+          if (_cursor->sequence.compare_exchange_weak(sequence, sequence | k_busy,
+                                                      std::memory_order_acquire, std::memory_order_relaxed)) {
+            break;
+          }
+        }
+      }
+
+      _gap = sequence - _expected;
+      _dropped += _gap;
+      _held = true;
+      return true;
+    }
+
+    void advance_to_held() noexcept {
+      if (_held) {
+        release(held_sequence());
+      }
+    }
+
+    /// moves the cursor to `sequence`, handing the slots before it back to the publishers.
+    void release(std::uint64_t sequence) noexcept {
+      _cursor->sequence.store(sequence, std::memory_order_release);
+      _expected = sequence;
+      _held = false;
+    }
+
+    void unsubscribe() noexcept {
+      if (_owner) {
+        // a publisher may be waiting on our busy flag.
+        advance_to_held();
+        _owner->unregister(_cursor.get());
+        _owner = nullptr;
       }
-      _head = std::move(head_next);
-      return _head->value;
     }
   };
 
-  PubSubQueue() : _tail(std::make_shared<Node>()) {}
+  /// `capacity` is rounded up to a power of two; with `LagPolicy::block`, `publish` waits on the slowest subscription.
+  explicit PubSubQueue(std::size_t capacity = 1024, LagPolicy policy = LagPolicy::block)
+    : _capacity(round_up_capacity(capacity))
+    , _mask(_capacity - 1)
+    , _policy(policy)
+    , _slots(std::make_unique<Slot[]>(_capacity))
+  {}
 
   PubSubQueue(const PubSubQueue&) = delete;
   PubSubQueue(PubSubQueue&&) noexcept = delete;
@@ -55,15 +319,118 @@ class PubSubQueue {
 
   ~PubSubQueue() = default;
 
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return _capacity; }
+  [[nodiscard]] auto policy() const noexcept -> LagPolicy { return _policy; }
+
+  /// can be called from any number of threads.
   void publish(value_type value) {
-    std::lock_guard lock{_mutex};
-    auto prev = std::exchange(_tail, std::make_shared<Node>(Node{.value = std::move(value)}));
-    std::atomic_store(&prev->next, _tail);
+    const auto sequence = _claim.fetch_add(1, std::memory_order_relaxed);
+    wait_for_slot(sequence);
+
+    auto& slot = slot_at(sequence);
+    // a publisher one lap behind may still be writing it.
+    for (std::size_t spin = 0; slot.published.load(std::memory_order_acquire) + _capacity < sequence + 1; ++spin) {
+      backoff(spin);
+    }
+    slot.value.emplace(std::move(value));
+    slot.published.store(sequence + 1, std::memory_order_release);
   }
 
   Subscription subscribe() {
-    std::shared_lock lock{_mutex};
-    return Subscription(_tail);
+    auto cursor = std::make_unique<Cursor>();
+    std::lock_guard lock{_registry_mutex};
+    // under the lock, so no publisher can lap it based on an older gating value.
+    cursor->sequence.store(_claim.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _cursors.push_back(cursor.get());
+    return Subscription(this, std::move(cursor));
+  }
+
+ private:
+  static constexpr auto round_up_capacity(std::size_t capacity) noexcept -> std::size_t {
+    std::size_t rounded = 1;
+    while (rounded < capacity) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  static void backoff(std::size_t spin) noexcept {
+    if (spin < k_spin_count) {
+      cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+  Slot& slot_at(std::uint64_t sequence) const noexcept {
+    return _slots[static_cast<std::size_t>(sequence & _mask)];
+  }
+
+  void unregister(Cursor* cursor) noexcept {
+    std::lock_guard lock{_registry_mutex};
+    // a disconnected cursor is already gone.
+    const auto found = std::find(_cursors.begin(), _cursors.end(), cursor);
+    if (found != _cursors.end()) {
+      _cursors.erase(found);
+    }
+  }
+
+  /// waits until no subscription still needs the message `capacity` sequences before `sequence`.
+  void wait_for_slot(std::uint64_t sequence) {
+    for (std::size_t spin = 0; sequence >= _gating_cache.load(std::memory_order_acquire) + _capacity; ++spin) {
+      if (sequence < update_gating_cache(sequence) + _capacity) {
+        return;
+      }
+      backoff(spin);
+    }
+  }
+
+  /**
+   * Applies the lag policy to the subscriptions that keep `sequence` from being written.
+   * @return the slowest subscription's sequence (the claim cursor if there is none).
+   */
+  std::uint64_t update_gating_cache(std::uint64_t sequence) {
+    std::lock_guard lock{_registry_mutex};
+    auto gating = _claim.load(std::memory_order_relaxed);
+    for (auto it = _cursors.begin(); it != _cursors.end();) {
+      auto position = (*it)->sequence.load(std::memory_order_acquire) & k_sequence_mask;
+      if (_policy != LagPolicy::block && sequence >= position + _capacity) {
+        position = evict(**it, sequence + 1 - _capacity);
+        if (position & k_disconnected) {
+          it = _cursors.erase(it);
+          continue;
+        }
+      }
+      gating = std::min(gating, position);
+      ++it;
+    }
+    _gating_cache.store(gating, std::memory_order_release);
+    return gating;
+  }
+
+  /**
+   * Moves a lagging cursor up to `target` (or disconnects it).
+   *
+   * A busy cursor is left alone: it keeps gating at its sequence, and the
+   * publisher retries from `wait_for_slot` once the registry lock is released,
+   * so a reader holding a slot never stalls subscribe/unsubscribe.
+   */
+  std::uint64_t evict(Cursor& cursor, std::uint64_t target) noexcept {
+    const auto desired = (_policy == LagPolicy::drop_oldest) ? target : k_disconnected;
+    auto position = cursor.sequence.load(std::memory_order_acquire);
+    while (true) {
+      if (position & k_busy) {
+        return position & k_sequence_mask;
+      }
+      if (position >= target) {
+        return position;
+      }
+      // acquire: the reader's last copy out of the slot happens before we overwrite it.
+      if (cursor.sequence.compare_exchange_weak(position, desired,
+                                                std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return desired;
+      }
+    }
   }
 };
 
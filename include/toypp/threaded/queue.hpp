@@ -8,12 +8,19 @@
 #include <thread>
 #include <utility>
 
+#include "toypp/hook_system.hpp"
+
 namespace tpp {
 
-template <typename T>
+/**
+ * @tparam Hooks enables `push_hook` / `pop_hook` (called with the value,
+ *   outside the lock); compiled out by default.
+ */
+template <typename T, bool Hooks = false>
 class MTQueue {
  public:
   using value_type = std::remove_cv_t<std::remove_reference_t<T>>;
+  using hook_type = BasicHook<Hooks, const value_type&>;
 
  private:
   struct Node {
@@ -25,6 +32,8 @@ class MTQueue {
   Node* head_ = nullptr;
   Node* tail_ = nullptr;
   std::atomic<std::size_t> size_ = 0;
+  hook_type push_hook_;
+  hook_type pop_hook_;
 
  public:
   MTQueue() {}
@@ -42,6 +51,9 @@ class MTQueue {
     return size_;
   }
 
+  [[nodiscard]] auto push_hook() noexcept -> hook_type& { return push_hook_; }
+  [[nodiscard]] auto pop_hook() noexcept -> hook_type& { return pop_hook_; }
+
   void clear()
   {
     std::lock_guard lk(mutex_);
@@ -57,6 +69,7 @@ class MTQueue {
   void push(const value_type& obj)
   {
     Node* node = new Node{obj, nullptr};
+    push_hook_(node->data);
     std::lock_guard lk(mutex_);
     push_node_unsafe(node);
   }
@@ -64,6 +77,7 @@ class MTQueue {
   void push(value_type&& obj)
   {
     Node* node = new Node{std::move(obj), nullptr};
+    push_hook_(node->data);
     std::lock_guard lk(mutex_);
     push_node_unsafe(node);
   }
@@ -93,6 +107,7 @@ class MTQueue {
     }
     delete node_to_delete;
 
+    pop_hook_(*ret);
     return ret;
   }
 
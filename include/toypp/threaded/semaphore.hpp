@@ -0,0 +1,164 @@
+#ifndef TOYPP_THREADED_SEMAPHORE_HPP_
+#define TOYPP_THREADED_SEMAPHORE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "toypp/threaded/cpu_relax.hpp"
+#include "toypp/threaded/futex.hpp"
+
+namespace tpp {
+
+/**
+ * Counting semaphore, spinning first and then parking on a futex.
+ *
+ * The count itself is the futex word: `acquire` spins `SpinCount` times
+ * on it, then registers as a waiter and sleeps until the count changes.
+ * `release` only makes a syscall when someone is parked; it wakes a single
+ * thread when that's enough, everyone when a batch `acquire(n)` is parked
+ * (a lone wake-up could land on a waiter that still can't proceed).
+ *
+ * Same semantics as `std::counting_semaphore`, with a runtime initial count.
+ */
+template <std::size_t SpinCount = 128>
+class BasicSemaphore {
+  std::atomic<std::uint32_t> count_;
+  std::atomic<std::uint32_t> waiters_{0};
+  std::atomic<std::uint32_t> batch_waiters_{0};
+
+ public:
+  explicit BasicSemaphore(std::uint32_t initial) noexcept : count_(initial) {}
+  BasicSemaphore(const BasicSemaphore&) = delete;
+  BasicSemaphore& operator=(const BasicSemaphore&) = delete;
+
+  /// takes `n` units, blocking until they are available.
+  void acquire(std::uint32_t n = 1) noexcept {
+    if (spin_acquire(n)) {
+      return;
+    }
+
+    park(n);
+    std::uint32_t observed = 0;
+    while (!try_acquire_parked(n, observed)) {
+      futex_wait(count_, observed);
+    }
+    unpark(n);
+  }
+
+  bool try_acquire(std::uint32_t n = 1) noexcept {
+    auto current = count_.load(std::memory_order_relaxed);
+    while (current >= n) {
+      if (count_.compare_exchange_weak(current, current - n, std::memory_order_acquire, std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @return false if `n` units couldn't be taken within `timeout`.
+  template <typename Rep, typename Period>
+  bool try_acquire_for(const std::chrono::duration<Rep, Period>& timeout, std::uint32_t n = 1) noexcept {
+    const auto deadline = deadline_after(timeout);
+    if (spin_acquire(n)) {
+      return true;
+    }
+
+    park(n);
+    std::uint32_t observed = 0;
+    bool acquired = try_acquire_parked(n, observed);
+    while (!acquired) {
+      const auto remaining = deadline - std::chrono::steady_clock::now();
+      const bool woken = futex_wait_for(count_, observed, remaining);
+      acquired = try_acquire_parked(n, observed);
+      if (!woken) {
+        break;
+      }
+    }
+    unpark(n);
+    return acquired;
+  }
+
+  /// gives back `n` units.
+  void release(std::uint32_t n = 1) noexcept {
+    count_.fetch_add(n, std::memory_order_seq_cst);
+    // pairs with `park`: either the waiter sees the new count, or we see the waiter.
+    if (waiters_.load(std::memory_order_seq_cst) == 0) {
+      return;
+    }
+    if (n == 1 && batch_waiters_.load(std::memory_order_seq_cst) == 0) {
+      futex_wake_one(count_);
+    } else {
+      futex_wake_all(count_);
+    }
+  }
+
+  /// units currently available; only a hint under concurrency.
+  [[nodiscard]] auto available() const noexcept -> std::uint32_t {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /**
+   * `now + timeout`, saturated: `duration::max()`-style timeouts mean "no
+   * deadline", and negative ones "now" (so `deadline - now` can't overflow either).
+   */
+  template <typename Rep, typename Period>
+  static auto deadline_after(const std::chrono::duration<Rep, Period>& timeout) noexcept
+    -> std::chrono::steady_clock::time_point {
+    using clock = std::chrono::steady_clock;
+    using wide = std::chrono::duration<long double, std::nano>;
+    const auto now = clock::now();
+    if (wide(timeout) <= wide::zero()) {
+      return now;
+    }
+    if (wide(timeout) >= wide(clock::time_point::max() - now)) {
+      return clock::time_point::max();
+    }
+    return now + std::chrono::duration_cast<clock::duration>(timeout);
+  }
+  bool spin_acquire(std::uint32_t n) noexcept {
+    for (std::size_t spin = 0; spin < SpinCount; ++spin) {
+      if (try_acquire(n)) {
+        return true;
+      }
+      cpu_relax();
+    }
+    return false;
+  }
+
+  /**
+   * `try_acquire` for a registered waiter; on failure, `observed` is the count
+   * it saw, so a release in between makes the futex wait return at once.
+   */
+  bool try_acquire_parked(std::uint32_t n, std::uint32_t& observed) noexcept {
+    observed = count_.load(std::memory_order_seq_cst);
+    while (observed >= n) {
+      if (count_.compare_exchange_weak(observed, observed - n, std::memory_order_acquire, std::memory_order_seq_cst)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void park(std::uint32_t n) noexcept {
+    if (n > 1) {
+      batch_waiters_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  void unpark(std::uint32_t n) noexcept {
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+    if (n > 1) {
+      batch_waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+using Semaphore = BasicSemaphore<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_SEMAPHORE_HPP_
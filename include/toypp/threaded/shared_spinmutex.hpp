@@ -0,0 +1,94 @@
+#ifndef TOYPP_THREADED_SHARED_SPINMUTEX_HPP_
+#define TOYPP_THREADED_SHARED_SPINMUTEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "toypp/threaded/cpu_relax.hpp"
+
+namespace tpp {
+
+/**
+ * Reader-writer spin lock.
+ *
+ * Any number of readers, or one writer. With `WriterPreference`, a waiting
+ * writer raises a flag that holds back new readers, so a steady stream of
+ * readers can't starve it; without it, readers get in whenever no writer owns
+ * the lock.
+ *
+ * Satisfies SharedLockable, so it works with `std::shared_lock` as well as
+ * `std::lock_guard` / `std::unique_lock`.
+ */
+template <bool WriterPreference = false>
+class BasicSharedSpinMutex {
+  static constexpr std::uint32_t k_writer = 0b01;
+  static constexpr std::uint32_t k_writer_pending = 0b10;
+  static constexpr std::uint32_t k_reader = 0b100;
+  static constexpr std::uint32_t k_spin_count = 1024;
+
+  std::atomic<std::uint32_t> state_{0};
+
+ public:
+  BasicSharedSpinMutex() {}
+  BasicSharedSpinMutex(const BasicSharedSpinMutex&) = delete;
+
+  void lock() noexcept {
+    for (std::uint32_t spin = 0;; ++spin) {
+      auto state = state_.load(std::memory_order_relaxed);
+      if ((state & ~k_writer_pending) == 0) {
+        if (state_.compare_exchange_weak(state, k_writer, std::memory_order_acquire, std::memory_order_relaxed))
+          return;
+        continue;
+      }
+      if constexpr (WriterPreference) {
+        if (!(state & k_writer_pending))
+          state_.fetch_or(k_writer_pending, std::memory_order_relaxed);
+      }
+      backoff(spin);
+    }
+  }
+
+  bool try_lock() noexcept {
+    auto state = state_.load(std::memory_order_relaxed);
+    return (state & ~k_writer_pending) == 0
+        && state_.compare_exchange_strong(state, k_writer, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    // keep a pending flag raised by another writer.
+    state_.fetch_and(~k_writer, std::memory_order_release);
+  }
+
+  void lock_shared() noexcept {
+    for (std::uint32_t spin = 0; !try_lock_shared(); ++spin)
+      backoff(spin);
+  }
+
+  bool try_lock_shared() noexcept {
+    auto state = state_.load(std::memory_order_relaxed);
+    if (state & blocking_readers_mask())
+      return false;
+    return state_.compare_exchange_strong(state, state + k_reader, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  void unlock_shared() noexcept { state_.fetch_sub(k_reader, std::memory_order_release); }
+
+ private:
+  static constexpr std::uint32_t blocking_readers_mask() noexcept {
+    return WriterPreference ? (k_writer | k_writer_pending) : k_writer;
+  }
+
+  static void backoff(std::uint32_t spin) noexcept {
+    if (spin < k_spin_count)
+      cpu_relax();
+    else
+      std::this_thread::yield();
+  }
+};
+
+using SharedSpinMutex = BasicSharedSpinMutex<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_SHARED_SPINMUTEX_HPP_
@@ -2,25 +2,62 @@
 #define TOYPP_THREADED_SPINMUTEX_HPP_
 
 #include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "toypp/threaded/cpu_relax.hpp"
 
 namespace tpp {
 
-class SpinMutex {
+/**
+ * Test-and-test-and-set spin lock with bounded exponential backoff.
+ *
+ * Waiters spin on a plain load (the cache line stays shared) and only try the
+ * exchange once the lock looks free; after each failed attempt they back off
+ * for twice as many `pause`s, up to `MaxBackoff`, then start yielding.
+ *
+ * Satisfies Lockable, so it works with `std::lock_guard`, `std::unique_lock`
+ * and `std::scoped_lock`.
+ */
+template <std::uint32_t MaxBackoff = 1024>
+class BasicSpinMutex {
   std::atomic<bool> flag_{false};
 
  public:
-  SpinMutex() {}
-  SpinMutex(const SpinMutex&) = delete;
+  BasicSpinMutex() {}
+  BasicSpinMutex(const BasicSpinMutex&) = delete;
+
+  void lock() noexcept {
+    std::uint32_t backoff = 1;
+    while (true) {
+      if (!flag_.exchange(true, std::memory_order_acquire))
+        return;
+
+      while (flag_.load(std::memory_order_relaxed)) {
+        for (std::uint32_t i = 0; i < backoff; ++i)
+          cpu_relax();
+
+        if (backoff < MaxBackoff)
+          backoff <<= 1;
+        else
+          std::this_thread::yield();
+      }
+    }
+  }
 
-  void acquire() noexcept {
-    bool current = false;
-    while (!flag_.compare_exchange_weak(current, true))
-      current = false;
+  bool try_lock() noexcept {
+    return !flag_.load(std::memory_order_relaxed)
+        && !flag_.exchange(true, std::memory_order_acquire);
   }
 
-  void release() noexcept { flag_.store(false); }
+  void unlock() noexcept { flag_.store(false, std::memory_order_release); }
+
+  void acquire() noexcept { lock(); }
+  void release() noexcept { unlock(); }
 };
 
+using SpinMutex = BasicSpinMutex<>;
+
 }  // namespace tpp
 
 #endif  // TOYPP_THREADED_SPINMUTEX_HPP_
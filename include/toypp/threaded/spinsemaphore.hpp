@@ -6,6 +6,10 @@
 
 namespace tpp {
 
+/**
+ * Busy-waiting semaphore, `MaxCount` permits (0: hardware concurrency).
+ * Waiters never sleep; prefer `Semaphore` (semaphore.hpp) when they may wait long.
+ */
 template <std::size_t MaxCount = 0>
 class SpinSemaphore {
  public:
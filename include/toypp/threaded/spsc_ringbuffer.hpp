@@ -1,65 +1,297 @@
 #ifndef TOYPP_THREADED_SPSC_RINGBUFFER_HPP_
 #define TOYPP_THREADED_SPSC_RINGBUFFER_HPP_
 
+#include <algorithm>
 #include <atomic>
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "toypp/span.hpp"
+#include "toypp/threaded/wait_strategy.hpp"
 
 namespace tpp {
 
+/**
+ * Default storage of `BasicSPSCRingBuffer`: a heap allocated byte array.
+ *
+ * A storage provides the bytes and the two cursors, and gets told after each
+ * publish (`on_write`) and consume (`on_read`), e.g. to persist them.
+ */
+class HeapRingStorage {
+  std::size_t size_ = 0;
+  std::unique_ptr<char[]> buffer_;
+  std::atomic<std::size_t> head_{0};
+  std::atomic<std::size_t> tail_{0};
+
+ public:
+  explicit HeapRingStorage(std::size_t size)
+    : size_(size)
+    , buffer_(std::make_unique<char[]>(size))
+  {}
+
+  [[nodiscard]] auto data() noexcept -> char* { return buffer_.get(); }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  [[nodiscard]] auto head() noexcept -> std::atomic<std::size_t>& { return head_; }
+  [[nodiscard]] auto tail() noexcept -> std::atomic<std::size_t>& { return tail_; }
+
+  void on_write() noexcept {}
+  void on_read() noexcept {}
+};
+
 /**
  * Thread-Safe wait-free single-procucer-single-consumer continugous ring buffer of bytes.
- * 
+ *
  * `read` (consumer) can be used by only one thread at a time.
  * `write` (producer) can be used by only one thread at a time.
  * `read` and `write` can be used in two different threads simultanously.
+ *
+ * Besides the raw byte stream, the buffer can carry length-prefixed records
+ * (framed mode) through `write_message`, `read_message` and `release_message`.
+ * A record is never split at the wrap point: when it does not fit in the tail
+ * of the buffer, a skip marker is written and the record starts over at the
+ * beginning. A buffer must be used either in byte mode or in framed mode.
+ *
+ * The `*_wait` variants block on the `WaitStrategy` while the buffer is empty
+ * (consumer) or full (producer); see "toypp/threaded/wait_strategy.hpp".
+ *
+ * @tparam WaitStrategy what a blocked side does while waiting.
+ * @tparam Storage where the bytes and cursors live; see `HeapRingStorage`.
  */
-class SPSCRingBuffer {
+template <typename WaitStrategy = BusySpinWait, typename Storage = HeapRingStorage>
+class BasicSPSCRingBuffer {
+ public:
+  using message_header_type = std::uint32_t;
+
+  static constexpr std::size_t k_message_alignment = sizeof(message_header_type);
+  static constexpr message_header_type k_skip_marker = ~message_header_type{0};
+
+ private:
+  Storage storage_;
   std::size_t buffer_size_ = 0;
-  std::unique_ptr<char[]> buffer_;
-  std::atomic<std::size_t> head_{0};
-  std::atomic<std::size_t> tail_{0};
+  char* buffer_ = nullptr;
+  std::atomic<std::size_t>& head_;
+  std::atomic<std::size_t>& tail_;
+  WaitStrategy readable_wait_{};
+  WaitStrategy writable_wait_{};
 
  public:
-  SPSCRingBuffer(std::size_t size)
-    : buffer_size_(size)
-    , buffer_(std::make_unique<char[]>(size)) 
+  /// in framed mode, `size` is rounded down to a multiple of `k_message_alignment`.
+  BasicSPSCRingBuffer(std::size_t size)
+    : BasicSPSCRingBuffer(std::in_place, size)
   {}
-  SPSCRingBuffer(const SPSCRingBuffer&) = delete;
-  SPSCRingBuffer(SPSCRingBuffer&&) noexcept = delete;
-  SPSCRingBuffer& operator=(const SPSCRingBuffer&) = delete;
-  SPSCRingBuffer& operator=(SPSCRingBuffer&&) noexcept = delete;
-  ~SPSCRingBuffer() = default;
+
+  /**
+   * Constructs the storage in place from `args`.
+   *
+   * @throw std::invalid_argument if the storage is smaller than 2 bytes (one is always kept free).
+   */
+  template <typename ...Args>
+  explicit BasicSPSCRingBuffer(std::in_place_t, Args&& ...args)
+    : storage_(std::forward<Args>(args)...)
+    , buffer_size_(storage_.size())
+    , buffer_(storage_.data())
+    , head_(storage_.head())
+    , tail_(storage_.tail())
+  {
+    if (buffer_size_ < 2) {
+      throw std::invalid_argument("tpp::SPSCRingBuffer: the ring needs at least 2 bytes.");
+    }
+  }
+  BasicSPSCRingBuffer(const BasicSPSCRingBuffer&) = delete;
+  BasicSPSCRingBuffer(BasicSPSCRingBuffer&&) noexcept = delete;
+  BasicSPSCRingBuffer& operator=(const BasicSPSCRingBuffer&) = delete;
+  BasicSPSCRingBuffer& operator=(BasicSPSCRingBuffer&&) noexcept = delete;
+  ~BasicSPSCRingBuffer() = default;
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return buffer_size_ - 1; }
 
   auto read(char* ptr, std::size_t size) -> std::size_t
   {
-    const auto head = head_.load();
-    const auto tail = tail_.load();
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_acquire);
     if (head == tail) {
         return 0;
     }
-    const auto readable_size = (head <= tail) ? (tail - head) : (buffer_size_ - head);
+    const auto readable_size = (head <= tail) ? (tail - head) : (buffer_size_ - head + tail);
     const auto read_count = std::min(size, readable_size);
-    std::memcpy(ptr, buffer_.get() + head, read_count);
-    head_ = (head <= tail) ? tail : 0;
+    const auto first_count = std::min(read_count, buffer_size_ - head);
+    std::memcpy(ptr, buffer_ + head, first_count);
+    std::memcpy(ptr + first_count, buffer_, read_count - first_count);
+    head_.store((head + read_count) % buffer_size_, std::memory_order_release);
+    storage_.on_read();
+    writable_wait_.notify();
+    return read_count;
+  }
+
+  /// blocks until at least one byte is read.
+  auto read_wait(char* ptr, std::size_t size) -> std::size_t
+  {
+    std::size_t read_count = 0;
+    readable_wait_.wait_until([&] { return size == 0 || (read_count = read(ptr, size)) != 0; });
     return read_count;
   }
 
   auto write(const char* ptr, std::size_t size) -> std::size_t
   {
-    const auto head = head_.load();
-    const auto tail = tail_.load();
-    if (buffer_size_ == (head + tail - 1)) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+    // one byte is always kept free, so `head == tail` only means empty.
+    const auto writable_size = (head <= tail) ? (buffer_size_ - tail + head - 1) : (head - tail - 1);
+    if (writable_size == 0) {
         return 0;
     }
-    const auto writable_size = (head <= tail) ? (buffer_size_ - tail) : (head - tail);
     const auto write_count = std::min(size, writable_size);
-    std::memcpy(buffer_.get() + tail, ptr, write_count);
-    tail_ = (head <= tail) ? 0 : head - 1;
+    const auto first_count = std::min(write_count, buffer_size_ - tail);
+    std::memcpy(buffer_ + tail, ptr, first_count);
+    std::memcpy(buffer_, ptr + first_count, write_count - first_count);
+    tail_.store((tail + write_count) % buffer_size_, std::memory_order_release);
+    storage_.on_write();
+    readable_wait_.notify();
     return write_count;
   }
+
+  /// blocks until at least one byte is written.
+  auto write_wait(const char* ptr, std::size_t size) -> std::size_t
+  {
+    std::size_t write_count = 0;
+    writable_wait_.wait_until([&] { return size == 0 || (write_count = write(ptr, size)) != 0; });
+    return write_count;
+  }
+
+  /**
+   * Publishes the whole record or nothing.
+   *
+   * @return false if there isn't enough contiguous room for the record right now.
+   */
+  auto write_message(Span<const char> message) -> bool
+  {
+    const auto ring_size = framed_size();
+    const auto record_size = record_size_of(message.size());
+    if (message.size() >= k_skip_marker || record_size >= ring_size) {
+      return false;
+    }
+
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto head = head_.load(std::memory_order_acquire);
+
+    // keep one aligned slot free between tail and head, so `head == tail` only means empty.
+    auto position = tail;
+    if (head <= tail) {
+      const auto tail_room = ring_size - tail - ((head == 0) ? k_message_alignment : 0);
+      if (record_size > tail_room) {
+        if (record_size + k_message_alignment > head) {
+          return false;
+        }
+        store_header(tail, k_skip_marker);
+        position = 0;
+      }
+    } else if (record_size + k_message_alignment > head - tail) {
+      return false;
+    }
+
+    store_header(position, static_cast<message_header_type>(message.size()));
+    std::memcpy(buffer_ + position + sizeof(message_header_type), message.data(), message.size());
+    tail_.store((position + record_size) % ring_size, std::memory_order_release);
+    storage_.on_write();
+    readable_wait_.notify();
+    return true;
+  }
+
+  /**
+   * Blocks until the record is published.
+   *
+   * @return false if the record can never fit in this buffer.
+   */
+  auto write_message_wait(Span<const char> message) -> bool
+  {
+    if (message.size() >= k_skip_marker || record_size_of(message.size()) >= framed_size()) {
+      return false;
+    }
+    writable_wait_.wait_until([&] { return write_message(message); });
+    return true;
+  }
+
+  /**
+   * Returns a view of the next complete record, without consuming it.
+   *
+   * The view stays valid until `release_message` is called.
+   */
+  auto read_message() -> std::optional<Span<const char>>
+  {
+    auto head = head_.load(std::memory_order_relaxed);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return std::nullopt;
+    }
+
+    auto length = load_header(head);
+    if (length == k_skip_marker) {
+      head = 0;
+      head_.store(head, std::memory_order_release);
+      storage_.on_read();
+      writable_wait_.notify();
+      if (head == tail) {
+        return std::nullopt;
+      }
+      length = load_header(head);
+    }
+
+    return Span<const char>(buffer_ + head + sizeof(message_header_type), length);
+  }
+
+  /// blocks until a complete record is available; see `read_message`.
+  auto read_message_wait() -> Span<const char>
+  {
+    std::optional<Span<const char>> message;
+    readable_wait_.wait_until([&] { return (message = read_message()).has_value(); });
+    return *message;
+  }
+
+  /// consumes the record last returned by `read_message`.
+  void release_message() noexcept
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto length = load_header(head);
+    head_.store((head + record_size_of(length)) % framed_size(), std::memory_order_release);
+    storage_.on_read();
+    writable_wait_.notify();
+  }
+
+ protected:
+  [[nodiscard]] auto storage() noexcept -> Storage& { return storage_; }
+
+  static constexpr auto record_size_of(std::size_t length) noexcept -> std::size_t
+  {
+    const auto size = sizeof(message_header_type) + length;
+    return (size + k_message_alignment - 1) / k_message_alignment * k_message_alignment;
+  }
+
+  [[nodiscard]] auto framed_size() const noexcept -> std::size_t
+  {
+    return buffer_size_ / k_message_alignment * k_message_alignment;
+  }
+
+  void store_header(std::size_t position, message_header_type header) noexcept
+  {
+    std::memcpy(buffer_ + position, &header, sizeof(header));
+  }
+
+  [[nodiscard]] auto load_header(std::size_t position) const noexcept -> message_header_type
+  {
+    message_header_type header = 0;
+    std::memcpy(&header, buffer_ + position, sizeof(header));
+    return header;
+  }
 };
 
+using SPSCRingBuffer = BasicSPSCRingBuffer<>;
+
 }  // namespace tpp
 
 #endif  // TOYPP_THREADED_SPSC_RINGBUFFER_HPP_
@@ -11,9 +11,20 @@
 #include <mutex>
 #include <condition_variable>
 
+#include "toypp/hook_system.hpp"
+
 namespace tpp {
 
-class ThreadPool {
+/**
+ * @tparam Hooks enables `task_start_hook` / `task_end_hook` (called by the
+ *   worker around each task); compiled out by default.
+ */
+template <bool Hooks = false>
+class BasicThreadPool {
+ public:
+  using hook_type = BasicHook<Hooks>;
+
+ private:
   using task_type = std::function<void()>;
 
   std::vector<std::thread> workers_;
@@ -22,6 +33,8 @@ class ThreadPool {
   std::queue<task_type>    queue_;
   std::atomic<bool>        halted_{false};
   std::atomic<bool>        shutdowned_{false};
+  hook_type                task_start_hook_;
+  hook_type                task_end_hook_;
 
   void worker_loop() {
     while (true) {
@@ -38,26 +51,28 @@ class ThreadPool {
         queue_.pop();
       }
 
+      task_start_hook_();
       task();
+      task_end_hook_();
     }
   }
 
  public:
-  ThreadPool() : ThreadPool(std::thread::hardware_concurrency()) {}
+  BasicThreadPool() : BasicThreadPool(std::thread::hardware_concurrency()) {}
 
-  ThreadPool(std::size_t size) {
+  BasicThreadPool(std::size_t size) {
     if (size == 0)
       size = std::thread::hardware_concurrency();
 
     workers_.reserve(size);
 
     for (std::size_t i = 0; i < size; ++i)
-      workers_.emplace_back(&ThreadPool::worker_loop, this);
+      workers_.emplace_back(&BasicThreadPool::worker_loop, this);
   }
 
-  ThreadPool(const ThreadPool&) = delete;
+  BasicThreadPool(const BasicThreadPool&) = delete;
 
-  ~ThreadPool() {
+  ~BasicThreadPool() {
     if (shutdowned_.load(std::memory_order_relaxed))
       return;
 
@@ -71,6 +86,10 @@ class ThreadPool {
 
   std::size_t workers_count() const noexcept { return workers_.size(); }
 
+  /// called by the worker right before / after each task; a relaxed load when unused.
+  hook_type& task_start_hook() noexcept { return task_start_hook_; }
+  hook_type& task_end_hook() noexcept { return task_end_hook_; }
+
   std::size_t jobs_count() noexcept {
     std::lock_guard<std::mutex> lock{mutex_};
     return queue_.size();
@@ -109,6 +128,8 @@ class ThreadPool {
   }
 };
 
+using ThreadPool = BasicThreadPool<>;
+
 }  // namespace tpp
 
 #endif  // TOYPP_THREADED_THREADPOOL_HPP_
@@ -0,0 +1,68 @@
+#ifndef TOYPP_THREADED_TICKET_SPINMUTEX_HPP_
+#define TOYPP_THREADED_TICKET_SPINMUTEX_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "toypp/threaded/cpu_relax.hpp"
+
+namespace tpp {
+
+/**
+ * FIFO-fair spin lock: threads take a ticket and get served in order.
+ *
+ * All waiters watch the same `now_serving` counter, so each one backs off
+ * proportionally to its distance from the head of the line, and yields when
+ * it's far from it or has been waiting for long.
+ *
+ * Same interface as SpinMutex (Lockable).
+ */
+class TicketSpinMutex {
+  static constexpr std::uint32_t k_pause_per_waiter = 64;
+  static constexpr std::uint32_t k_yield_distance = 4;
+  static constexpr std::uint32_t k_spin_count = 1024;  // pauses before yielding.
+
+  alignas(64) std::atomic<std::uint32_t> next_ticket_{0};
+  alignas(64) std::atomic<std::uint32_t> now_serving_{0};
+
+ public:
+  TicketSpinMutex() {}
+  TicketSpinMutex(const TicketSpinMutex&) = delete;
+
+  void lock() noexcept {
+    const auto ticket = next_ticket_.fetch_add(1, std::memory_order_relaxed);
+    for (std::uint32_t paused = 0;;) {
+      const auto serving = now_serving_.load(std::memory_order_acquire);
+      if (serving == ticket)
+        return;
+
+      // far from the head of the line, or the owner looks descheduled.
+      const auto distance = ticket - serving;
+      if (distance >= k_yield_distance || paused >= k_spin_count) {
+        std::this_thread::yield();
+        continue;
+      }
+      const auto pauses = distance * k_pause_per_waiter;
+      for (std::uint32_t i = 0; i < pauses; ++i)
+        cpu_relax();
+      paused += pauses;
+    }
+  }
+
+  bool try_lock() noexcept {
+    auto serving = now_serving_.load(std::memory_order_relaxed);
+    return next_ticket_.compare_exchange_strong(serving, serving + 1,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    // only the owner writes `now_serving_`.
+    now_serving_.store(now_serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_TICKET_SPINMUTEX_HPP_
@@ -0,0 +1,81 @@
+#ifndef TOYPP_THREADED_TRIPLEBUFFER_HPP_
+#define TOYPP_THREADED_TRIPLEBUFFER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+namespace tpp {
+
+/**
+ * @brief A non-blocking alternative to DoubleBuffer, for one writer and one reader.
+ *
+ * Three buffers rotate between the writer, the reader and a "middle" slot.
+ * `writer_publish` swaps the writer buffer with the middle one and returns
+ * immediately, so a slow reader never stalls the writer; unread snapshots are
+ * simply overwritten. `reader_arrive` swaps the middle buffer in when a newer
+ * snapshot was published, so the reader always sees the latest complete one.
+ *
+ * @tparam BufferT buffer type.
+ */
+template <typename BufferT>
+class TripleBuffer {
+ public:
+  using buffer_type = BufferT;
+
+ private:
+  static constexpr std::uint8_t k_index_mask = 0b011;
+  static constexpr std::uint8_t k_fresh_bit = 0b100;
+
+  struct alignas(64) Slot {
+    buffer_type buffer{};
+  };
+
+  Slot _slots[3] = {};
+  std::uint8_t _writer_index = 0;
+  alignas(64) std::atomic<std::uint8_t> _middle{1};
+  alignas(64) std::uint8_t _reader_index = 2;
+
+ public:
+  TripleBuffer() {}
+
+  TripleBuffer(buffer_type a, buffer_type b, buffer_type c)
+    : _slots{{std::move(a)}, {std::move(b)}, {std::move(c)}}
+  {}
+
+  /// publishes the writer buffer; the writer continues on a recycled one.
+  void writer_publish() noexcept {
+    const auto previous = _middle.exchange(_writer_index | k_fresh_bit, std::memory_order_acq_rel);
+    _writer_index = previous & k_index_mask;
+  }
+
+  /// @return true if a newer snapshot became the reader buffer.
+  bool reader_arrive() noexcept {
+    if (!(_middle.load(std::memory_order_relaxed) & k_fresh_bit)) {
+      return false;
+    }
+    const auto previous = _middle.exchange(_reader_index, std::memory_order_acq_rel);
+    _reader_index = previous & k_index_mask;
+    return true;
+  }
+
+  buffer_type& reader_buffer() noexcept {
+    return _slots[_reader_index].buffer;
+  }
+
+  const buffer_type& reader_buffer() const noexcept {
+    return _slots[_reader_index].buffer;
+  }
+
+  buffer_type& writer_buffer() noexcept {
+    return _slots[_writer_index].buffer;
+  }
+
+  const buffer_type& writer_buffer() const noexcept {
+    return _slots[_writer_index].buffer;
+  }
+};
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_TRIPLEBUFFER_HPP_
@@ -0,0 +1,112 @@
+#ifndef TOYPP_THREADED_WAIT_STRATEGY_HPP_
+#define TOYPP_THREADED_WAIT_STRATEGY_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "toypp/threaded/cpu_relax.hpp"
+#include "toypp/threaded/futex.hpp"
+
+namespace tpp {
+
+/**
+ * Wait strategies decide what a waiting side does while its condition isn't met.
+ *
+ * Every strategy provides:
+ *  - `wait_until(ready)`: returns once `ready()` returned true.
+ *  - `notify()`: called by the other side after it made progress.
+ *
+ * From the lowest latency to the lowest cpu usage:
+ * BusySpinWait, SpinPauseWait, YieldWait, FutexWait.
+ */
+
+struct BusySpinWait {
+  template <typename Pred>
+  void wait_until(Pred&& ready) noexcept(noexcept(ready())) {
+    while (!ready()) {
+      // do nothing.
+    }
+  }
+
+  void notify() noexcept {}
+};
+
+struct SpinPauseWait {
+  template <typename Pred>
+  void wait_until(Pred&& ready) noexcept(noexcept(ready())) {
+    while (!ready()) {
+      cpu_relax();
+    }
+  }
+
+  void notify() noexcept {}
+};
+
+struct YieldWait {
+  template <typename Pred>
+  void wait_until(Pred&& ready) noexcept(noexcept(ready())) {
+    while (!ready()) {
+      std::this_thread::yield();
+    }
+  }
+
+  void notify() noexcept {}
+};
+
+/**
+ * Spins for a while, then parks the thread on a futex.
+ *
+ * The waiter announces itself in `sleepers_` before its last check of `ready()`,
+ * so `notify` skips the wake-up syscall when nobody is sleeping. It still
+ * pays a `seq_cst` fence on every call, which every successful non-blocking
+ * read or write of a ring buffer triggers: about 2ns per write + read round
+ * trip over `BusySpinWait` (see benchmark/threaded/spsc_ringbuffer.cpp).
+ */
+template <std::size_t SpinCount = 128>
+class BasicFutexWait {
+  std::atomic<std::uint32_t> epoch_{0};
+  std::atomic<std::uint32_t> sleepers_{0};
+
+ public:
+  template <typename Pred>
+  void wait_until(Pred&& ready) noexcept(noexcept(ready())) {
+    for (std::size_t spin = 0; spin < SpinCount; ++spin) {
+      if (ready()) {
+        return;
+      }
+      cpu_relax();
+    }
+
+    while (true) {
+      const auto epoch = epoch_.load(std::memory_order_acquire);
+      sleepers_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if (ready()) {
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+
+      futex_wait(epoch_, epoch);
+      sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void notify() noexcept {
+    // pairs with the fence in `wait_until`: either the waiter sees our progress,
+    // or we see the waiter.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+      return;
+    }
+    epoch_.fetch_add(1, std::memory_order_release);
+    futex_wake_all(epoch_);
+  }
+};
+
+using FutexWait = BasicFutexWait<>;
+
+}  // namespace tpp
+
+#endif  // TOYPP_THREADED_WAIT_STRATEGY_HPP_
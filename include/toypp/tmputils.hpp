@@ -1,6 +1,7 @@
 #ifndef TOYPP_TMPUTILS_HPP_
 #define TOYPP_TMPUTILS_HPP_
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
@@ -82,12 +83,12 @@ struct type_pack<T, Ts...> {
   using rest  = type_pack<Ts...>;
 
   template <template <typename ...> typename Template, typename ...Us>
-  using expand_into = Template<Ts..., Us...>;
+  using expand_into = Template<T, Ts..., Us...>;
 
   template <template <typename ...> typename Template, typename ...Us>
-  using rexpand_into = Template<Us..., Ts...>;
+  using rexpand_into = Template<Us..., T, Ts...>;
 
-  constexpr static auto count = sizeof...(Ts);
+  constexpr static auto count = 1 + sizeof...(Ts);
   constexpr static auto size() noexcept { return count; }
 };
 
@@ -139,12 +140,12 @@ struct value_pack<X, Xs...> {
   using rest = value_pack<Xs...>;
 
   template <template <auto ...> typename Template, auto ...Ys>
-  using expand_into = Template<Xs..., Ys...>;
+  using expand_into = Template<X, Xs..., Ys...>;
 
   template <template <auto ...> typename Template, auto ...Ys>
-  using rexpand_into = Template<Ys..., Xs...>;
+  using rexpand_into = Template<Ys..., X, Xs...>;
 
-  constexpr static auto count = sizeof...(Xs);
+  constexpr static auto count = 1 + sizeof...(Xs);
   constexpr static auto size() noexcept { return count; }
 };
 
@@ -444,6 +445,24 @@ struct pack_does_contain {
 template <typename A, typename ...Ts>
 constexpr inline bool pack_does_contain_v = pack_does_contain<A, Ts...>::value;
 
+// -- pack_index_of
+
+template <typename A, typename ...Ts>
+struct pack_index_of {};
+
+template <typename A, typename ...Ts>
+struct pack_index_of<A, A, Ts...> {
+  constexpr static std::size_t value = 0;
+};
+
+template <typename A, typename T, typename ...Ts>
+struct pack_index_of<A, T, Ts...> {
+  constexpr static std::size_t value = 1 + pack_index_of<A, Ts...>::value;
+};
+
+template <typename A, typename ...Ts>
+constexpr inline std::size_t pack_index_of_v = pack_index_of<A, Ts...>::value;
+
 }  // namespace tpp
 
 #endif  // TOYPP_TMPUTILS_HPP_
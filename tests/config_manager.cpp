@@ -0,0 +1,154 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/config_manager.hpp"
+
+namespace {
+
+auto write_temp_file(const char* name, const std::string& content) -> std::string {
+  auto path = std::filesystem::temp_directory_path() / (name + std::to_string(::getpid()));
+  std::ofstream(path) << content;
+  return path.string();
+}
+
+}  // namespace
+
+TEST_CASE("tpp::ConfigManager") {
+  SECTION("typed keys, defaults and set") {
+    tpp::ConfigManager config;
+
+    const auto workers = config.key<std::int64_t>("workers", 4);
+    const auto ratio = config.key("ratio", 0.5);
+    const auto verbose = config.key("verbose", false);
+    const auto name = config.key("name", "service");
+
+    CHECK(config.get(workers) == 4);
+    CHECK(config.get(ratio) == 0.5);
+    CHECK(!config.get(verbose));
+    CHECK(config.get(name) == "service");
+
+    // interning again gives the same handle.
+    CHECK(config.key<std::int64_t>("workers").index() == workers.index());
+    CHECK_THROWS_AS(config.key<double>("workers"), std::runtime_error);
+
+    config.set(workers, std::int64_t{8});
+    config.set(name, std::string("renamed"));
+
+    const auto view = config.view();
+    CHECK(view[workers] == 8);
+    CHECK(view.get(name) == "renamed");
+    CHECK(view.version() == 2);
+  }
+
+  SECTION("updates while holding a view") {
+    tpp::ConfigManager config;
+    const auto limit = config.key<std::int64_t>("limit", 1);
+
+    const auto view = config.view();
+    config.set(limit, std::int64_t{2});
+    const auto other = config.key("other", true);
+    config.set(limit, std::int64_t{3});
+
+    CHECK(view[limit] == 1);
+    CHECK(view.version() == 0);
+    CHECK(config.get(limit) == 3);
+    CHECK(config.get(other));
+  }
+
+  SECTION("change notifications") {
+    tpp::ConfigManager config;
+    const auto limit = config.key<std::int64_t>("limit", 1);
+    const auto other = config.key<std::int64_t>("other", 1);
+
+    auto changes = config.subscribe();
+    CHECK(changes.dequeue() == std::nullopt);
+
+    config.set(limit, std::int64_t{2});
+    const auto change = changes.dequeue();
+    REQUIRE(change);
+    CHECK(change->is(limit));
+    CHECK(!change->is(other));
+    CHECK(change->version == config.version());
+  }
+
+  SECTION("loads a file") {
+    const auto path = write_temp_file("toypp-config-",
+                                      "# service settings\n"
+                                      "workers = 16\n"
+                                      "verbose = yes  # trailing comment\n"
+                                      "name = \"edge\"\n"
+                                      "ratio=0.25\n"
+                                      "broken = twelve\n");
+
+    tpp::ConfigManager config;
+    const auto workers = config.key<std::int64_t>("workers", 4);
+    auto changes = config.subscribe();
+
+    config.load_file(path);
+    CHECK(config.get(workers) == 16);
+    REQUIRE(changes.dequeue());
+    CHECK(changes.dequeue() == std::nullopt);
+
+    // converted when interned.
+    CHECK(config.key("verbose", false).index() == 1);
+    CHECK(config.get(config.key("verbose", false)));
+    CHECK(config.get(config.key("name", "")) == "edge");
+    CHECK(config.get(config.key("ratio", 1.0)) == 0.25);
+    CHECK(config.get(config.key("missing", "default")) == "default");
+    CHECK_THROWS_AS(config.key<std::int64_t>("broken"), std::runtime_error);
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("a bad file changes nothing") {
+    const auto path = write_temp_file("toypp-config-bad-", "workers = 2\nlimit = lots\n");
+
+    tpp::ConfigManager config;
+    const auto workers = config.key<std::int64_t>("workers", 4);
+    const auto limit = config.key<std::int64_t>("limit", 10);
+
+    CHECK_THROWS_AS(config.load_file(path), std::runtime_error);
+    CHECK(config.get(workers) == 4);
+    CHECK(config.get(limit) == 10);
+    CHECK_THROWS_AS(config.load_file(path + ".missing"), std::system_error);
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("readers see consistent snapshots") {
+    tpp::ConfigManager config;
+    const auto low = config.key<std::int64_t>("low", 0);
+    const auto high = config.key<std::int64_t>("high", 1);
+    std::atomic<bool> running{true};
+    std::atomic<bool> failed{false};
+
+    std::thread reader([&] {
+      while (running) {
+        const auto view = config.view();
+        if (view[high] != view[low] + 1) {
+          failed = true;
+        }
+      }
+    });
+
+    const auto path = std::filesystem::temp_directory_path() / ("toypp-config-swap-" + std::to_string(::getpid()));
+    for (std::int64_t i = 1; i <= 50; ++i) {
+      std::ofstream(path) << "low = " << i << "\nhigh = " << i + 1 << "\n";
+      config.load_file(path.string());
+    }
+    running = false;
+    reader.join();
+
+    CHECK(!failed);
+    CHECK(config.get(low) == 50);
+    std::filesystem::remove(path);
+  }
+}
@@ -0,0 +1,185 @@
+#include <atomic>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/event_system.hpp"
+#include "toypp/tmputils.hpp"
+
+namespace {
+
+struct Click {
+  int x = 0;
+  int y = 0;
+};
+
+struct Key {
+  char code = 0;
+};
+
+struct Message {
+  std::string text;
+};
+
+int g_clicks = 0;
+
+void count_click(const Click&) { ++g_clicks; }
+
+struct KeyLogger {
+  std::string keys;
+
+  void on_key(const Key& key) { keys += key.code; }
+};
+
+struct KeyCounter {
+  int* count = nullptr;
+
+  void on_key(const Key&) const { ++*count; }
+};
+
+}  // namespace
+
+static_assert(tpp::pack_index_of_v<int, int, char, long> == 0);
+static_assert(tpp::pack_index_of_v<long, int, char, long> == 2);
+static_assert(tpp::type_pack<int, char, long>::count == 3);
+static_assert(std::is_same_v<tpp::type_pack<int, char>::expand_into<tpp::type_pack, long>,
+                             tpp::type_pack<int, char, long>>);
+static_assert(std::is_same_v<tpp::type_pack<int, char>::rexpand_into<tpp::type_pack, long>,
+                             tpp::type_pack<long, int, char>>);
+
+TEST_CASE("tpp::EventSystem") {
+  using events_type = tpp::EventSystem<Click, Key, Message>;
+
+  SECTION("dispatches by event type") {
+    events_type events;
+    g_clicks = 0;
+
+    KeyLogger logger;
+    std::vector<std::string> messages;
+    auto on_message = [&](const Message& message) { messages.push_back(message.text); };
+
+    events.subscribe(&count_click);
+    events.subscribe<Key, &KeyLogger::on_key>(logger);
+    events.subscribe<Message>(on_message);
+
+    events.emit(Click{1, 2});
+    events.emit(Key{'a'});
+    events.emit(Key{'b'});
+    events.emit(Message{"hello"});
+
+    CHECK(g_clicks == 1);
+    CHECK(logger.keys == "ab");
+    CHECK(messages == std::vector<std::string>{"hello"});
+  }
+
+  SECTION("handlers run in subscription order") {
+    events_type events;
+    std::string order;
+    auto first = [&](const Key&) { order += '1'; };
+    auto second = [&](const Key&) { order += '2'; };
+
+    events.subscribe<Key>(first);
+    const auto id = events.subscribe<Key>(second);
+    events.subscribe<Key>(first);
+    CHECK(events.handlers_count<Key>() == 3);
+    CHECK(events.handlers_count<Click>() == 0);
+
+    events.emit(Key{});
+    CHECK(order == "121");
+
+    CHECK(events.unsubscribe<Key>(id));
+    CHECK(!events.unsubscribe<Key>(id));
+    CHECK(!events.unsubscribe<Click>(id + 100));
+
+    events.emit(Key{});
+    CHECK(order == "12111");
+  }
+
+  SECTION("post delivers on the thread pool") {
+    tpp::ThreadPool pool{2};
+    events_type events{pool};
+
+    std::atomic<int> sum{0};
+    auto on_click = [&](const Click& click) { sum += click.x; };
+    events.subscribe<Click>(on_click);
+
+    for (int x = 1; x <= 100; ++x) {
+      events.post(Click{x, 0});
+    }
+    pool.shutdown();
+
+    CHECK(sum == 5050);
+  }
+
+  SECTION("post on a hooked thread pool") {
+    tpp::BasicThreadPool<true> pool{1};
+    events_type events{pool};
+
+    std::atomic<int> tasks{0};
+    auto on_task_end = [&] { ++tasks; };
+    pool.task_end_hook().add(on_task_end);
+    std::atomic<int> sum{0};
+    auto on_click = [&](const Click& click) { sum += click.x; };
+    events.subscribe<Click>(on_click);
+
+    events.post(Click{1, 0});
+    events.post(Click{2, 0});
+    pool.shutdown();
+
+    CHECK(sum == 3);
+    CHECK(tasks == 2);
+  }
+
+  SECTION("without locking") {
+    tpp::BasicEventSystem<tpp::NoLock, Click, Key> events;
+    int clicks = 0;
+    auto on_click = [&](const Click&) { ++clicks; };
+    events.subscribe<Click>(on_click);
+
+    events.emit(Click{});
+    events.emit(Key{});
+    CHECK(clicks == 1);
+  }
+
+  SECTION("post without a pool emits right away") {
+    events_type events;
+    std::string text;
+    auto on_message = [&](const Message& message) { text = message.text; };
+    events.subscribe<Message>(on_message);
+
+    events.post(Message{"now"});
+    CHECK(text == "now");
+  }
+
+  SECTION("const handlers") {
+    events_type events;
+    int keys = 0;
+    const auto on_key = [&keys](const Key&) { ++keys; };
+    const KeyCounter counter{&keys};
+
+    events.subscribe<Key>(on_key);
+    events.subscribe<Key, &KeyCounter::on_key>(counter);
+
+    events.emit(Key{});
+    CHECK(keys == 2);
+  }
+
+  SECTION("event types from a type_pack") {
+    using events_list = tpp::type_pack<Click, Key>;
+    tpp::EventSystem<events_list> events;
+    static_assert(decltype(events)::index_of<Key> == 1);
+
+    int clicks = 0;
+    auto on_click = [&](const Click&) { ++clicks; };
+    events.subscribe<Click>(on_click);
+    events.subscribe<Click>(+[](const Click&) { ++g_clicks; });
+
+    g_clicks = 0;
+    events.emit(Click{});
+    events.emit(Key{});
+    CHECK(clicks == 1);
+    CHECK(g_clicks == 1);
+  }
+}
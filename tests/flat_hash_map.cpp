@@ -0,0 +1,173 @@
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/flat_hash_map.hpp"
+
+namespace {
+
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+};
+
+/// sends every key to the same home slot.
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 0; }
+};
+
+/// counts live instances; copies throw once `copies_left` runs out.
+struct Counted {
+  static inline int live = 0;
+  static inline int copies_left = 0;
+  int value = 0;
+
+  Counted(int v) : value(v) { ++live; }
+  Counted(const Counted& other) : value(other.value) {
+    if (copies_left-- <= 0) throw std::runtime_error("copy");
+    ++live;
+  }
+  Counted(Counted&& other) noexcept : value(other.value) { ++live; }
+  Counted& operator=(const Counted&) = default;
+  Counted& operator=(Counted&&) noexcept = default;
+  ~Counted() { --live; }
+};
+
+}  // namespace
+
+TEST_CASE("tpp::FlatHashMap") {
+  SECTION("insert, at and remove") {
+    tpp::FlatHashMap<int, std::string> map;
+    CHECK(map.empty());
+    CHECK(map.at(1) == nullptr);
+
+    CHECK(map.insert(1, "one"));
+    CHECK(map.insert(2, "two"));
+    CHECK(!map.insert(1, "uno"));
+    CHECK(*map.at(1) == "one");
+
+    CHECK(map.insert_or_assign(1, "uno"));
+    CHECK(*map.at(1) == "uno");
+    CHECK(map.size() == 2);
+
+    map[3] = "three";
+    CHECK(map[3] == "three");
+    CHECK(map[4].empty());
+    CHECK(map.size() == 4);
+
+    CHECK(map.remove(2));
+    CHECK(!map.remove(2));
+    CHECK(!map.contains(2));
+    CHECK(map.size() == 3);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.at(1) == nullptr);
+  }
+
+  SECTION("heterogeneous lookup") {
+    tpp::FlatHashMap<std::string, int, StringHash, std::equal_to<>> map;
+    map.insert("alpha", 1);
+    map.insert("beta", 2);
+
+    constexpr std::string_view beta = "beta";
+    CHECK(*map.at(beta) == 2);
+    CHECK(map.contains("alpha"));
+    CHECK(!map.contains(std::string_view("gamma")));
+    CHECK(map.remove(beta));
+    CHECK(map.size() == 1);
+  }
+
+  SECTION("matches std::map under random operations") {
+    tpp::FlatHashMap<std::uint32_t, std::uint32_t> map;
+    std::map<std::uint32_t, std::uint32_t> reference;
+    std::mt19937 rng{42};
+
+    for (int step = 0; step < 100000; ++step) {
+      const auto key = rng() % 4096;
+      if (rng() % 3 == 0) {
+        CHECK(map.remove(key) == (reference.erase(key) == 1));
+      } else {
+        CHECK(map.insert(key, key * 2) == reference.emplace(key, key * 2).second);
+      }
+    }
+
+    CHECK(map.size() == reference.size());
+    CHECK(map.load_factor() <= 0.875);
+    for (const auto& [key, value] : reference) {
+      REQUIRE(map.at(key));
+      CHECK(*map.at(key) == value);
+    }
+
+    std::size_t visited = 0;
+    for (const auto& [key, value] : map) {
+      CHECK(reference.at(key) == value);
+      ++visited;
+    }
+    CHECK(visited == reference.size());
+  }
+
+  SECTION("a broken hash throws once probes get too long") {
+    tpp::FlatHashMap<int, int, CollidingHash> map;
+    for (int key = 0; key < 254; ++key) {
+      map[key] = key;
+    }
+    CHECK_THROWS_AS(map.insert(254, 254), std::length_error);
+    CHECK(map.size() == 254);
+
+    for (int key = 0; key < 254; key += 2) {
+      CHECK(map.remove(key));
+    }
+    for (int key = 0; key < 254; ++key) {
+      CHECK(map.contains(key) == (key % 2 == 1));
+    }
+    CHECK(map.insert(254, 254));
+  }
+
+  SECTION("copy, move and move-only values") {
+    tpp::FlatHashMap<int, std::unique_ptr<int>> map;
+    for (int key = 0; key < 100; ++key) {
+      map.insert(key, std::make_unique<int>(key));
+    }
+
+    auto moved = std::move(map);
+    CHECK(map.empty());
+    CHECK(**moved.at(42) == 42);
+
+    tpp::FlatHashMap<int, int> source;
+    source.reserve(1000);
+    const auto capacity = source.capacity();
+    for (int key = 0; key < 1000; ++key) {
+      source.insert(key, -key);
+    }
+    CHECK(source.capacity() == capacity);
+
+    auto copy = source;
+    source.remove(7);
+    CHECK(*copy.at(7) == -7);
+    CHECK(copy.size() == 1000);
+  }
+
+  SECTION("a throwing copy leaks nothing") {
+    {
+      tpp::FlatHashMap<int, Counted> source;
+      for (int key = 0; key < 50; ++key) {
+        source.insert(key, Counted{key});
+      }
+      CHECK(Counted::live == 50);
+
+      Counted::copies_left = 20;
+      using map_type = tpp::FlatHashMap<int, Counted>;
+      CHECK_THROWS_AS(map_type(source), std::runtime_error);
+      CHECK(Counted::live == 50);
+    }
+    CHECK(Counted::live == 0);
+  }
+}
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/flatmap.hpp"
+#include "toypp/frozen_flatmap.hpp"
+#include "toypp/soa_container.hpp"
+
+namespace {
+
+template <typename Map>
+auto keys_of(const Map& map) -> std::vector<int> {
+  std::vector<int> keys;
+  for (const auto& entry : map) {
+    keys.push_back(entry.first);
+  }
+  return keys;
+}
+
+/// throws when copied once `copies_left` runs out.
+struct ThrowingValue {
+  static inline int copies_left = 0;
+  int value = 0;
+
+  ThrowingValue(int v) : value(v) {}
+  ThrowingValue(const ThrowingValue& other) : value(other.value) {
+    if (copies_left-- <= 0) throw std::runtime_error("copy");
+  }
+  ThrowingValue& operator=(const ThrowingValue&) = default;
+};
+
+struct CaseInsensitiveLess {
+  bool operator()(const std::string& lhs, const std::string& rhs) const {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+      return std::tolower(static_cast<unsigned char>(a)) < std::tolower(static_cast<unsigned char>(b));
+    });
+  }
+};
+
+}  // namespace
+
+TEST_CASE("tpp::FlatMap") {
+  SECTION("matches std::map under random operations") {
+    tpp::FlatMap<int, int> map;
+    std::map<int, int> reference;
+    std::mt19937 rng{11};
+
+    for (int step = 0; step < 20000; ++step) {
+      const auto key = static_cast<int>(rng() % 512);
+      if (rng() % 3 == 0) {
+        CHECK(map.remove(key) == (reference.erase(key) == 1));
+      } else {
+        CHECK(map.insert(key, -key) == reference.emplace(key, -key).second);
+      }
+    }
+
+    REQUIRE(map.size() == reference.size());
+    CHECK(std::equal(map.begin(), map.end(), reference.begin(), reference.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first == rhs.first && lhs.second == rhs.second; }));
+    for (int key = 0; key < 512; ++key) {
+      CHECK((map.at(key) != nullptr) == (reference.count(key) == 1));
+    }
+  }
+
+  SECTION("ascending and descending inserts") {
+    tpp::FlatMap<int, int> map;
+    for (int key = 0; key < 100; ++key) {
+      CHECK(map.insert(key, key));
+      CHECK(map.insert(-key - 1, key));
+    }
+    CHECK(map.size() == 200);
+    CHECK(std::is_sorted(map.begin(), map.end()));
+    CHECK(map[42] == 42);
+    CHECK(map[1000] == 0);
+    CHECK(map.size() == 201);
+  }
+
+  SECTION("keys are equivalent through Compare only") {
+    tpp::FlatMap<std::string, int, CaseInsensitiveLess> map;
+    CHECK(map.insert("Hello", 1));
+    CHECK(map.insert("world", 2));
+    CHECK(!map.insert("HELLO", 3));
+    CHECK(*map.at("hello") == 1);
+    CHECK(map.remove("WORLD"));
+    CHECK(map.size() == 1);
+  }
+}
+
+TEST_CASE("tpp::FrozenFlatMap") {
+  SECTION("every size finds its keys and misses the gaps") {
+    for (int size = 0; size < 140; ++size) {
+      std::vector<std::pair<int, int>> pairs;
+      for (int index = 0; index < size; ++index) {
+        pairs.emplace_back(index * 2 + 1, -index);
+      }
+      std::shuffle(pairs.begin(), pairs.end(), std::mt19937{static_cast<unsigned>(size)});
+
+      const tpp::FrozenFlatMap<int, int> map(tpp::from_unsorted, pairs);
+      REQUIRE(map.size() == static_cast<std::size_t>(size));
+      for (int index = 0; index < size; ++index) {
+        REQUIRE(map.at(index * 2 + 1));
+        CHECK(*map.at(index * 2 + 1) == -index);
+        CHECK(!map.contains(index * 2));
+      }
+      CHECK(!map.contains(size * 2 + 1));
+    }
+  }
+
+  SECTION("built from a FlatMap") {
+    const tpp::FlatMap<std::string, int, CaseInsensitiveLess> source(
+        tpp::from_unsorted, std::vector<std::pair<std::string, int>>{{"b", 2}, {"A", 1}, {"c", 3}});
+
+    const tpp::FrozenFlatMap<std::string, int, CaseInsensitiveLess> map(source);
+    CHECK(*map.at("a") == 1);
+    CHECK(*map.at("C") == 3);
+    CHECK(map.at("d") == nullptr);
+  }
+}
+
+TEST_CASE("tpp::FlatMap bulk operations") {
+  using map_type = tpp::FlatMap<int, std::string>;
+
+  SECTION("from unsorted pairs") {
+    const std::vector<std::pair<int, std::string>> pairs{
+        {5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}, {4, "four"}, {5, "cinq"}};
+
+    const map_type map(tpp::from_unsorted, pairs);
+    CHECK(map.size() == 4);
+    CHECK(keys_of(map) == std::vector<int>{1, 3, 4, 5});
+    CHECK(*map.at(1) == "one");
+    CHECK(*map.at(5) == "five");
+    CHECK(map.at(2) == nullptr);
+
+    const map_type empty(tpp::from_unsorted, std::vector<std::pair<int, std::string>>{});
+    CHECK(empty.empty());
+  }
+
+  SECTION("moves out of an rvalue range") {
+    std::vector<std::pair<int, std::unique_ptr<int>>> pairs;
+    pairs.emplace_back(2, std::make_unique<int>(20));
+    pairs.emplace_back(1, std::make_unique<int>(10));
+
+    tpp::FlatMap<int, std::unique_ptr<int>> map(tpp::from_unsorted, std::move(pairs));
+    CHECK(**map.at(1) == 10);
+    CHECK(**map.at(2) == 20);
+  }
+
+  SECTION("adopts a sorted container") {
+    std::vector<std::pair<int, std::string>> sorted{{1, "a"}, {2, "b"}, {7, "c"}};
+    const map_type map(tpp::sorted_unique, std::move(sorted));
+    CHECK(map.size() == 3);
+    CHECK(*map.at(7) == "c");
+  }
+
+  SECTION("bulk insert merges in place") {
+    map_type map(tpp::sorted_unique, {{2, "two"}, {4, "four"}, {6, "six"}});
+
+    const std::vector<std::pair<int, std::string>> batch{
+        {7, "seven"}, {4, "vier"}, {1, "one"}, {5, "five"}, {1, "eins"}};
+    CHECK(map.insert_bulk(batch) == 3);
+    CHECK(keys_of(map) == std::vector<int>{1, 2, 4, 5, 6, 7});
+    CHECK(*map.at(4) == "four");
+    CHECK(*map.at(1) == "one");
+
+    CHECK(map.insert_bulk(std::vector<std::pair<int, std::string>>{}) == 0);
+    CHECK(map.insert_bulk(batch) == 0);
+    CHECK(map.size() == 6);
+  }
+
+  SECTION("bulk insert at scale") {
+    std::vector<std::pair<int, int>> pairs;
+    for (int index = 0; index < 10000; ++index) {
+      pairs.emplace_back((index * 7919) % 10007, index);
+    }
+
+    tpp::FlatMap<int, int> map(tpp::from_unsorted, std::vector<std::pair<int, int>>(pairs.begin(), pairs.begin() + 5000));
+    CHECK(map.insert_bulk(pairs) == 5000);
+    CHECK(map.size() == 10000);
+    for (const auto& [key, value] : pairs) {
+      REQUIRE(map.at(key));
+      CHECK(*map.at(key) == value);
+    }
+  }
+}
+
+TEST_CASE("tpp::SoAFlatMap") {
+  SECTION("matches std::map under random operations") {
+    tpp::SoAFlatMap<int, std::string> map;
+    std::map<int, std::string> reference;
+    std::mt19937 rng{5};
+
+    for (int step = 0; step < 20000; ++step) {
+      const auto key = static_cast<int>(rng() % 512);
+      if (rng() % 3 == 0) {
+        CHECK(map.remove(key) == (reference.erase(key) == 1));
+      } else {
+        CHECK(map.insert(key, std::to_string(key)) == reference.emplace(key, std::to_string(key)).second);
+      }
+    }
+
+    REQUIRE(map.size() == reference.size());
+    auto expected = reference.begin();
+    for (const auto& entry : map) {
+      CHECK(entry.first == expected->first);
+      CHECK(entry.second == expected->second);
+      ++expected;
+    }
+  }
+
+  SECTION("bulk operations sort through proxies") {
+    const std::vector<std::pair<int, std::string>> pairs{{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+    tpp::SoAFlatMap<int, std::string> map(tpp::from_unsorted, pairs);
+    CHECK(keys_of(map) == std::vector<int>{1, 2, 3});
+    CHECK(*map.at(1) == "a");
+
+    CHECK(map.insert_bulk(std::vector<std::pair<int, std::string>>{{0, "z"}, {2, "y"}, {9, "i"}}) == 2);
+    CHECK(keys_of(map) == std::vector<int>{0, 1, 2, 3, 9});
+    CHECK(*map.at(2) == "b");
+    map[4] = "d";
+    CHECK(*map.at(4) == "d");
+
+    const tpp::FrozenFlatMap<int, std::string> frozen(map);
+    CHECK(*frozen.at(9) == "i");
+  }
+
+  SECTION("the container keeps keys dense") {
+    tpp::SoAContainer<int, std::string> container{{3, "c"}, {1, "a"}, {2, "b"}};
+    std::sort(container.begin(), container.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    CHECK(container.keys() == std::vector<int>{1, 2, 3});
+    CHECK(container.values() == std::vector<std::string>{"a", "b", "c"});
+
+    std::pair<int, std::string> copy = container[1];
+    container[1].second = "B";
+    CHECK(copy.second == "b");
+    CHECK(container.begin()[1].second == "B");
+    CHECK(container.end() - container.begin() == 3);
+
+    container.erase(container.begin());
+    CHECK(container.keys() == std::vector<int>{2, 3});
+  }
+
+  SECTION("a throwing range insert leaves both arrays as they were") {
+    ThrowingValue::copies_left = 100;
+    tpp::SoAContainer<int, ThrowingValue> container;
+    container.emplace_back(1, ThrowingValue{1});
+    const std::vector<std::pair<int, ThrowingValue>> entries{{2, 2}, {3, 3}};
+
+    // the second value throws, after its key went in.
+    ThrowingValue::copies_left = 1;
+    CHECK_THROWS_AS(container.insert(container.begin(), entries.begin(), entries.end()), std::runtime_error);
+    CHECK(container.size() == 1);
+    CHECK(container.keys() == std::vector<int>{1});
+    CHECK(container.values().size() == 1);
+  }
+
+  SECTION("move-only values") {
+    tpp::SoAFlatMap<int, std::unique_ptr<int>> map;
+    map.insert(2, std::make_unique<int>(2));
+    map.insert(1, std::make_unique<int>(1));
+    CHECK(map.remove(2));
+    CHECK(**map.at(1) == 1);
+  }
+}
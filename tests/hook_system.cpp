@@ -0,0 +1,158 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/hook_system.hpp"
+#include "toypp/threaded/queue.hpp"
+#include "toypp/threaded/threadpool.hpp"
+
+namespace {
+
+int g_calls = 0;
+
+void count_call(int) { ++g_calls; }
+
+struct Recorder {
+  std::vector<int> values;
+
+  void record(int value) { values.push_back(value); }
+};
+
+struct OnSave { using hook_type = tpp::Hook<const std::string&>; };
+struct OnLoad { using hook_type = tpp::Hook<>; };
+struct OnTrace { using hook_type = tpp::BasicHook<false, int>; };
+
+}  // namespace
+
+static_assert(std::is_empty_v<tpp::BasicHook<false, int>>);
+
+TEST_CASE("tpp::Hook") {
+  SECTION("add, call, remove") {
+    tpp::Hook<int> hook;
+    g_calls = 0;
+    CHECK(!hook.active());
+    hook(1);
+
+    Recorder recorder;
+    int sum = 0;
+    auto add = [&](int value) { sum += value; };
+
+    const auto free_id = hook.add(&count_call);
+    const auto member_id = hook.add<&Recorder::record>(recorder);
+    const auto lambda_id = hook.add(add);
+    CHECK(hook.active());
+
+    hook(2);
+    hook(3);
+    CHECK(g_calls == 2);
+    CHECK(recorder.values == std::vector<int>{2, 3});
+    CHECK(sum == 5);
+
+    CHECK(hook.remove(member_id));
+    CHECK(!hook.remove(member_id));
+    hook(4);
+    CHECK(recorder.values.size() == 2);
+    CHECK(sum == 9);
+
+    CHECK(hook.remove(free_id));
+    CHECK(hook.remove(lambda_id));
+    CHECK(!hook.active());
+    hook(5);
+    CHECK(sum == 9);
+  }
+
+  SECTION("disabled hooks do nothing") {
+    tpp::BasicHook<false, int> hook;
+    hook(1);
+    CHECK(!hook.active());
+  }
+
+  SECTION("calls run concurrently with registration") {
+    tpp::Hook<> hook;
+    std::atomic<int> calls{0};
+    auto count = [&] { calls.fetch_add(1, std::memory_order_relaxed); };
+    std::atomic<bool> running{true};
+
+    std::thread caller([&] {
+      while (running) {
+        hook();
+      }
+    });
+
+    for (int i = 0; i < 50; ++i) {
+      const auto id = hook.add(count);
+      std::this_thread::yield();
+      hook.remove(id);
+    }
+    running = false;
+    caller.join();
+    CHECK(!hook.active());
+  }
+}
+
+TEST_CASE("tpp::HookSystem") {
+  tpp::HookSystem<OnSave, OnLoad, OnTrace> hooks;
+
+  std::string saved;
+  int loads = 0;
+  auto on_save = [&](const std::string& name) { saved = name; };
+  auto on_load = [&] { ++loads; };
+  hooks.hook<OnSave>().add(on_save);
+  hooks.hook<OnLoad>().add(on_load);
+
+  hooks.call<OnSave>(std::string("doc"));
+  hooks.call<OnLoad>();
+  hooks.call<OnTrace>(1);
+
+  CHECK(saved == "doc");
+  CHECK(loads == 1);
+  CHECK(!hooks.hook<OnTrace>().active());
+}
+
+TEST_CASE("hooked MTQueue and ThreadPool") {
+  SECTION("queue push and pop") {
+    tpp::MTQueue<int, true> queue;
+    std::vector<int> pushed;
+    std::vector<int> popped;
+    auto on_push = [&](const int& value) { pushed.push_back(value); };
+    auto on_pop = [&](const int& value) { popped.push_back(value); };
+    queue.push_hook().add(on_push);
+    queue.pop_hook().add(on_pop);
+
+    queue.push(1);
+    queue.push(2);
+    CHECK(queue.pop() == 1);
+
+    CHECK(pushed == std::vector<int>{1, 2});
+    CHECK(popped == std::vector<int>{1});
+  }
+
+  SECTION("pool task start and end") {
+    std::atomic<int> started{0};
+    std::atomic<int> ended{0};
+    auto on_start = [&] { ++started; };
+    auto on_end = [&] { ++ended; };
+
+    tpp::BasicThreadPool<true> pool{2};
+    pool.task_start_hook().add(on_start);
+    pool.task_end_hook().add(on_end);
+
+    for (int i = 0; i < 10; ++i) {
+      pool.add_task([] {});
+    }
+    pool.shutdown();
+
+    CHECK(started == 10);
+    CHECK(ended == 10);
+  }
+
+  SECTION("hooks are compiled out by default") {
+    static_assert(!tpp::ThreadPool::hook_type::enabled);
+    static_assert(std::is_empty_v<tpp::ThreadPool::hook_type>);
+    static_assert(!tpp::MTQueue<int>::hook_type::enabled);
+  }
+}
@@ -0,0 +1,72 @@
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/perfect_hash_map.hpp"
+
+namespace {
+
+using namespace std::string_view_literals;
+
+enum class Method { get, head, post, put, patch, del };
+
+constexpr auto k_methods = tpp::make_perfect_hash_map<std::string_view, Method>({
+    {"GET"sv, Method::get},
+    {"HEAD"sv, Method::head},
+    {"POST"sv, Method::post},
+    {"PUT"sv, Method::put},
+    {"PATCH"sv, Method::patch},
+    {"DELETE"sv, Method::del},
+});
+
+static_assert(k_methods.size() == 6);
+static_assert(*k_methods.at("POST") == Method::post);
+static_assert(*k_methods.at("DELETE") == Method::del);
+static_assert(k_methods.at("OPTIONS") == nullptr);
+static_assert(!k_methods.contains("get"));
+
+constexpr auto k_names = tpp::make_perfect_hash_map<Method, std::string_view>({
+    {Method::get, "GET"sv},
+    {Method::put, "PUT"sv},
+});
+
+static_assert(*k_names.at(Method::put) == "PUT");
+static_assert(k_names.at(Method::post) == nullptr);
+
+}  // namespace
+
+TEST_CASE("tpp::PerfectHashMap") {
+  SECTION("runtime lookups in a constexpr map") {
+    const std::string method = "PATCH";
+    CHECK(*k_methods.at(method) == Method::patch);
+    CHECK(k_methods.at(method + "!") == nullptr);
+  }
+
+  SECTION("larger key sets, built at runtime") {
+    constexpr std::size_t k_size = 2000;
+    std::array<std::pair<std::uint64_t, std::uint64_t>, k_size> entries{};
+    for (std::size_t index = 0; index < k_size; ++index) {
+      entries[index] = {index * 0x9E3779B97F4A7C15ull, index};
+    }
+
+    const tpp::PerfectHashMap<std::uint64_t, std::uint64_t, k_size> map(entries);
+    for (const auto& [key, value] : entries) {
+      REQUIRE(map.at(key));
+      CHECK(*map.at(key) == value);
+    }
+    for (std::uint64_t key = 1; key < 1000; ++key) {
+      CHECK(!map.contains(key));
+    }
+  }
+
+  SECTION("duplicate keys are rejected") {
+    using map_type = tpp::PerfectHashMap<int, int, 3>;
+    CHECK_THROWS_AS(map_type({{1, 1}, {2, 2}, {1, 3}}), std::logic_error);
+  }
+}
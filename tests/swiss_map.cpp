@@ -0,0 +1,206 @@
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/swiss_map.hpp"
+
+namespace {
+
+struct StringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+};
+
+/// sends every key to the same group, with the same `h2`.
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 0; }
+};
+
+/// counts live instances; copies throw once `copies_left` runs out, and moves
+/// aren't noexcept, so the map has to copy when growing.
+struct Counted {
+  static inline int live = 0;
+  static inline int copies_left = 0;
+  int value = 0;
+
+  Counted(int v) : value(v) { ++live; }
+  Counted(const Counted& other) : value(other.value) {
+    if (copies_left-- <= 0) throw std::runtime_error("copy");
+    ++live;
+  }
+  Counted(Counted&& other) : value(other.value) { ++live; }
+  Counted& operator=(const Counted&) = default;
+  Counted& operator=(Counted&&) = default;
+  ~Counted() { --live; }
+};
+
+#if defined(TOYPP_SWISS_HAS_SSE2)
+using group_types = std::tuple<tpp::SwissScalarGroup, tpp::SwissSse2Group>;
+#else
+using group_types = std::tuple<tpp::SwissScalarGroup>;
+#endif
+
+}  // namespace
+
+TEMPLATE_LIST_TEST_CASE("tpp::SwissMap groups", "", group_types) {
+  alignas(16) std::uint8_t ctrl[tpp::SwissCtrl::group_width];
+  std::memset(ctrl, tpp::SwissCtrl::empty, sizeof(ctrl));
+  ctrl[0] = 0x12;
+  ctrl[3] = 0x12;
+  ctrl[7] = 0x13;
+  ctrl[8] = tpp::SwissCtrl::deleted;
+  ctrl[15] = 0x12;
+
+  const TestType group(ctrl);
+  CHECK(group.match(0x12) == ((1u << 0) | (1u << 3) | (1u << 15)));
+  CHECK(group.match(0x13) == (1u << 7));
+  CHECK(group.match(0x00) == 0);
+  CHECK(group.match_empty() == (0xFFFFu & ~((1u << 0) | (1u << 3) | (1u << 7) | (1u << 8) | (1u << 15))));
+  CHECK(group.match_empty_or_deleted() == (0xFFFFu & ~((1u << 0) | (1u << 3) | (1u << 7) | (1u << 15))));
+
+  // every `h2` against a full group of distinct bytes.
+  for (std::uint8_t h2 = 0; h2 < 0x80; ++h2) {
+    for (std::size_t index = 0; index < sizeof(ctrl); ++index) {
+      ctrl[index] = static_cast<std::uint8_t>((h2 + index) & 0x7F);
+    }
+    CHECK(TestType(ctrl).match(h2) == 1u);
+    CHECK(TestType(ctrl).match_empty_or_deleted() == 0);
+  }
+}
+
+TEMPLATE_LIST_TEST_CASE("tpp::SwissMap", "", group_types) {
+  SECTION("insert, at and remove") {
+    tpp::SwissMap<int, std::string, std::hash<int>, std::equal_to<int>, TestType> map;
+    CHECK(map.empty());
+    CHECK(map.at(1) == nullptr);
+
+    CHECK(map.insert(1, "one"));
+    CHECK(map.insert(2, "two"));
+    CHECK(!map.insert(1, "uno"));
+    CHECK(*map.at(1) == "one");
+
+    CHECK(map.insert_or_assign(1, "uno"));
+    CHECK(*map.at(1) == "uno");
+
+    map[3] = "three";
+    CHECK(map[3] == "three");
+    CHECK(map.size() == 3);
+
+    CHECK(map.remove(2));
+    CHECK(!map.remove(2));
+    CHECK(!map.contains(2));
+    CHECK(map.size() == 2);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.at(1) == nullptr);
+  }
+
+  SECTION("heterogeneous lookup") {
+    tpp::SwissMap<std::string, int, StringHash, std::equal_to<>, TestType> map;
+    map.insert("alpha", 1);
+    map.insert("beta", 2);
+
+    CHECK(*map.at(std::string_view("beta")) == 2);
+    CHECK(map.contains("alpha"));
+    CHECK(map.remove(std::string_view("alpha")));
+    CHECK(map.size() == 1);
+  }
+
+  SECTION("matches std::map under random operations") {
+    tpp::SwissMap<std::uint32_t, std::uint32_t, std::hash<std::uint32_t>, std::equal_to<std::uint32_t>, TestType> map;
+    std::map<std::uint32_t, std::uint32_t> reference;
+    std::mt19937 rng{7};
+
+    for (int step = 0; step < 100000; ++step) {
+      const auto key = rng() % 4096;
+      if (rng() % 3 == 0) {
+        CHECK(map.remove(key) == (reference.erase(key) == 1));
+      } else {
+        CHECK(map.insert(key, key + 1) == reference.emplace(key, key + 1).second);
+      }
+    }
+
+    CHECK(map.size() == reference.size());
+    for (const auto& [key, value] : reference) {
+      REQUIRE(map.at(key));
+      CHECK(*map.at(key) == value);
+    }
+
+    std::size_t visited = 0;
+    for (const auto& [key, value] : map) {
+      CHECK(reference.at(key) == value);
+      ++visited;
+    }
+    CHECK(visited == reference.size());
+  }
+
+  SECTION("tombstones are reclaimed") {
+    tpp::SwissMap<int, int, std::hash<int>, std::equal_to<int>, TestType> map;
+    map.reserve(100);
+    const auto capacity = map.capacity();
+
+    for (int round = 0; round < 100; ++round) {
+      for (int key = 0; key < 100; ++key) {
+        map.insert(round * 100 + key, key);
+      }
+      for (int key = 0; key < 100; ++key) {
+        CHECK(map.remove(round * 100 + key));
+      }
+    }
+    CHECK(map.empty());
+    CHECK(map.capacity() == capacity);
+  }
+
+  SECTION("colliding keys probe past full groups") {
+    tpp::SwissMap<int, int, CollidingHash, std::equal_to<int>, TestType> map;
+    for (int key = 0; key < 200; ++key) {
+      map[key] = -key;
+    }
+    for (int key = 0; key < 200; key += 3) {
+      CHECK(map.remove(key));
+    }
+    for (int key = 0; key < 200; ++key) {
+      CHECK(map.contains(key) == (key % 3 != 0));
+    }
+  }
+
+  SECTION("throwing copies leak nothing and lose nothing") {
+    using map_type = tpp::SwissMap<int, Counted, std::hash<int>, std::equal_to<int>, TestType>;
+    {
+      Counted::copies_left = 0;
+      map_type map;
+      map.insert(0, Counted{0});
+      const auto capacity = map.capacity();
+      int key = 1;
+      for (; map.size() < capacity - capacity / 8; ++key) {
+        map.insert(key, Counted{key});
+      }
+      CHECK(map.capacity() == capacity);
+      const auto live = Counted::live;
+
+      // growing copies every entry: the third copy throws.
+      Counted::copies_left = 2;
+      CHECK_THROWS_AS(map.insert(key, Counted{key}), std::runtime_error);
+      CHECK(map.capacity() == capacity);
+      CHECK(Counted::live == live);
+      for (int old = 0; old < key; ++old) {
+        REQUIRE(map.contains(old));
+        CHECK(map.at(old)->value == old);
+      }
+
+      Counted::copies_left = 5;
+      CHECK_THROWS_AS(map_type(map), std::runtime_error);
+      CHECK(Counted::live == live);
+    }
+    CHECK(Counted::live == 0);
+  }
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/atomic_snapshot.hpp"
+
+TEST_CASE("tpp::AtomicSnapshot") {
+  SECTION("read-store-update") {
+    tpp::AtomicSnapshot<std::string> snapshot{tpp::make_shared<std::string>("hello")};
+
+    {
+      const auto guard = snapshot.read();
+      CHECK(*guard == "hello");
+      CHECK(guard->size() == 5);
+    }
+
+    snapshot.update([](std::string& value) { value += " world"; });
+    CHECK(*snapshot.read() == "hello world");
+
+    const auto kept = snapshot.load();
+    CHECK(kept.use_count() == 2);
+
+    snapshot.store(tpp::make_shared<std::string>("bye"));
+    CHECK(*snapshot.read() == "bye");
+    CHECK(*kept == "hello world");
+    CHECK(kept.use_count() == 1);
+
+    tpp::AtomicSnapshot<std::string> empty{};
+    CHECK(!empty.read());
+  }
+
+  SECTION("old values are reclaimed through the SharedPtr deleter") {
+    std::size_t deleted = 0;
+    auto deleter = [&deleted](int* ptr) { ++deleted; delete ptr; };
+
+    tpp::AtomicSnapshot<int> snapshot{tpp::SharedPtr<int>(new int(1), deleter)};
+    snapshot.store(tpp::SharedPtr<int>(new int(2), deleter));
+    CHECK(deleted == 1);
+    snapshot.store(tpp::SharedPtr<int>(new int(3), deleter));
+    CHECK(deleted == 2);
+  }
+
+  SECTION("deferred updates don't wait for the readers") {
+    std::size_t deleted = 0;
+    auto deleter = [&deleted](int* ptr) { ++deleted; delete ptr; };
+    tpp::AtomicSnapshot<int> snapshot{tpp::SharedPtr<int>(new int(1), deleter)};
+
+    {
+      const auto guard = snapshot.read();
+      snapshot.update_deferred([](int& value) { value = 2; });
+      snapshot.update_deferred([](int& value) { value = 3; });
+      CHECK(*guard == 1);
+      CHECK(*snapshot.read() == 3);
+      CHECK(deleted == 0);
+    }
+
+    // the copies are made with make_shared: only the first value counts.
+    snapshot.update_deferred([](int& value) { value = 4; });
+    snapshot.update_deferred([](int& value) { value = 5; });
+    CHECK(deleted == 1);
+    CHECK(*snapshot.read() == 5);
+  }
+
+  SECTION("readers see whole values while the writer updates") {
+    constexpr std::size_t count = 2'000;
+    constexpr std::size_t reader_count = 4;
+    tpp::AtomicSnapshot<std::vector<std::size_t>> snapshot{
+      tpp::make_shared<std::vector<std::size_t>>(16, 0)};
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (std::size_t index = 0; index < reader_count; ++index) {
+      readers.emplace_back([&] {
+        std::size_t last = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+          const auto guard = snapshot.read();
+          const auto& values = *guard;
+          bool ok = values.size() == 16 && values.front() >= last;
+          for (auto value : values) {
+            ok &= (value == values.front());
+          }
+          if (!ok) {
+            failed = true;
+          }
+          last = values.front();
+        }
+      });
+    }
+
+    for (std::size_t value = 1; value <= count; ++value) {
+      snapshot.update([value](std::vector<std::size_t>& values) {
+        for (auto& item : values) {
+          item = value;
+        }
+      });
+    }
+    done = true;
+
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    CHECK(!failed);
+    CHECK(snapshot.read()->front() == count);
+  }
+}
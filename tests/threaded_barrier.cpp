@@ -0,0 +1,65 @@
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/barrier.hpp"
+
+TEMPLATE_TEST_CASE("tpp::Barrier", "", tpp::FutexWait, tpp::YieldWait) {
+  SECTION("phases are separated, completion runs once per phase") {
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t phase_count = 200;
+    std::atomic<std::size_t> arrivals{0};
+    std::size_t completions = 0;
+    bool failed = false;
+
+    auto on_completion = [&]() noexcept {
+      // every thread arrived at this phase, and no one at the next one yet.
+      failed |= (arrivals.load() != (completions + 1) * thread_count);
+      ++completions;
+    };
+    tpp::BasicBarrier<decltype(on_completion), TestType> barrier{thread_count, on_completion};
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&] {
+        for (std::size_t phase = 0; phase < phase_count; ++phase) {
+          arrivals.fetch_add(1);
+          barrier.arrive_and_wait();
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(!failed);
+    CHECK(completions == phase_count);
+  }
+
+  SECTION("arrive_and_drop") {
+    tpp::BasicBarrier<tpp::EmptyCompletion, TestType> barrier{2};
+
+    std::thread leaver([&] { barrier.arrive_and_drop(); });
+    barrier.arrive_and_wait();
+    leaver.join();
+
+    // alone from now on.
+    barrier.arrive_and_wait();
+    barrier.arrive_and_wait();
+  }
+}
+
+static_assert(std::is_same_v<tpp::Barrier, tpp::BasicBarrier<tpp::EmptyCompletion, tpp::FutexWait>>);
+
+TEST_CASE("tpp::BasicBarrier deduces the completion function") {
+  int completions = 0;
+  tpp::BasicBarrier barrier{1, [&] { ++completions; }};
+
+  barrier.arrive_and_wait();
+  barrier.arrive_and_wait();
+  CHECK(completions == 2);
+}
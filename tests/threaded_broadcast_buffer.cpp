@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/broadcast_buffer.hpp"
+
+TEST_CASE("tpp::BroadcastBuffer") {
+  SECTION("readers registration") {
+    tpp::BroadcastBuffer<int, 2> bbuff{42};
+
+    auto reader_a = bbuff.make_reader();
+    auto reader_b = bbuff.make_reader();
+    REQUIRE(reader_a);
+    REQUIRE(reader_b);
+    CHECK(!bbuff.make_reader());
+
+    CHECK(reader_a->reader_buffer() == 42);
+
+    reader_b.reset();
+    CHECK(bbuff.make_reader());
+  }
+
+  SECTION("publish-arrive") {
+    tpp::BroadcastBuffer<int, 2> bbuff{};
+    auto reader_a = bbuff.make_reader();
+    auto reader_b = bbuff.make_reader();
+
+    CHECK(!reader_a->reader_arrive());
+
+    bbuff.writer_buffer() = 1;
+    bbuff.writer_publish();
+
+    CHECK(reader_a->reader_arrive());
+    CHECK(reader_a->reader_buffer() == 1);
+    CHECK(!reader_a->reader_arrive());
+
+    // reader_b stalls on its snapshot; the writer keeps going.
+    for (int value = 2; value < 10; ++value) {
+      bbuff.writer_buffer() = value;
+      bbuff.writer_publish();
+      CHECK(reader_a->reader_arrive());
+      CHECK(reader_a->reader_buffer() == value);
+      CHECK(reader_b->reader_buffer() == 0);
+    }
+
+    CHECK(reader_b->reader_arrive());
+    CHECK(reader_b->reader_buffer() == 9);
+  }
+
+  SECTION("snapshots are complete and never go back in time") {
+    constexpr std::uint64_t count = 20'000;
+    constexpr std::size_t reader_count = 4;
+    tpp::BroadcastBuffer<std::vector<std::uint64_t>, reader_count> bbuff{std::vector<std::uint64_t>(8, 0)};
+
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (std::size_t index = 0; index < reader_count; ++index) {
+      readers.emplace_back([&failed, reader = bbuff.make_reader()]() mutable {
+        std::uint64_t last = 0;
+        while (last != count) {
+          if (!reader->reader_arrive()) {
+            std::this_thread::yield();
+            continue;
+          }
+          const auto& snapshot = reader->reader_buffer();
+          bool ok = snapshot.size() == 8 && snapshot.front() > last;
+          for (auto value : snapshot) {
+            ok &= (value == snapshot.front());
+          }
+          if (!ok) {
+            failed = true;
+          }
+          last = snapshot.front();
+        }
+      });
+    }
+
+    for (std::uint64_t value = 1; value <= count; ++value) {
+      bbuff.writer_buffer().assign(8, value);
+      bbuff.writer_publish();
+    }
+
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    CHECK(!failed);
+  }
+}
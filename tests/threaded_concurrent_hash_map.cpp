@@ -0,0 +1,147 @@
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/concurrent_hash_map.hpp"
+
+namespace {
+
+/// every word derives from the key: a torn read can't pass `valid`.
+struct Entry {
+  std::uint64_t key = 0;
+  std::uint64_t generation = 0;
+  std::uint64_t check = 0;
+
+  static Entry make(std::uint64_t key, std::uint64_t generation) noexcept {
+    return {key, generation, key * 31 + generation * 17};
+  }
+
+  bool valid(std::uint64_t expected_key) const noexcept {
+    return key == expected_key && check == key * 31 + generation * 17;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("tpp::ConcurrentHashMap") {
+  SECTION("matches std::map on random operations") {
+    tpp::ConcurrentHashMap<int, int, std::hash<int>, std::equal_to<int>, 4> map;
+    static_assert(decltype(map)::optimistic_reads);
+    std::map<int, int> expected;
+
+    std::mt19937 rng{42};
+    for (int step = 0; step < 20'000; ++step) {
+      const int key = static_cast<int>(rng() % 512);
+      switch (rng() % 3) {
+        case 0:
+          CHECK(map.insert_or_assign(key, step) == expected.insert_or_assign(key, step).second);
+          break;
+        case 1:
+          CHECK(map.erase(key) == (expected.erase(key) == 1));
+          break;
+        default: {
+          const auto found = expected.find(key);
+          const auto value = map.get(key);
+          REQUIRE(value.has_value() == (found != expected.end()));
+          if (value) CHECK(*value == found->second);
+        }
+      }
+    }
+    CHECK(map.size() == expected.size());
+    for (const auto& [key, value] : expected) {
+      CHECK(map.get(key) == value);
+    }
+  }
+
+  SECTION("compute_if_absent") {
+    tpp::ConcurrentHashMap<int, int> map;
+    int calls = 0;
+    CHECK(map.compute_if_absent(1, [&] { ++calls; return 10; }) == 10);
+    CHECK(map.compute_if_absent(1, [&] { ++calls; return 20; }) == 10);
+    CHECK(calls == 1);
+    CHECK(map.get(1) == 10);
+
+    CHECK_THROWS_AS(map.compute_if_absent(2, []() -> int { throw std::runtime_error("no"); }), std::runtime_error);
+    CHECK(!map.contains(2));
+    CHECK(map.size() == 1);
+  }
+
+  SECTION("non trivially copyable types lock for reads") {
+    tpp::ConcurrentHashMap<std::string, std::string> map;
+    static_assert(!decltype(map)::optimistic_reads);
+
+    CHECK(map.insert_or_assign("a", "1"));
+    CHECK(!map.insert_or_assign("a", "2"));
+    CHECK(map.get("a") == std::string("2"));
+    CHECK(map.compute_if_absent("b", [] { return std::string("3"); }) == "3");
+    CHECK(map.size() == 2);
+    CHECK(map.erase("a"));
+    CHECK(!map.erase("a"));
+    CHECK(!map.get("a"));
+  }
+
+  SECTION("readers never see torn values while writers grow and erase") {
+    constexpr std::uint64_t key_count = 4'096;
+    constexpr std::size_t reader_count = 3;
+    tpp::ConcurrentHashMap<std::uint64_t, Entry, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>, 8> map;
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (std::size_t index = 0; index < reader_count; ++index) {
+      readers.emplace_back([&, index] {
+        std::uint64_t key = index;
+        while (!done.load(std::memory_order_relaxed)) {
+          key = (key + 7) % key_count;
+          if (const auto entry = map.get(key); entry && !entry->valid(key)) {
+            failed = true;
+          }
+        }
+      });
+    }
+
+    std::thread writer([&] {
+      for (std::uint64_t generation = 0; generation < 4; ++generation) {
+        for (std::uint64_t key = 0; key < key_count; ++key) {
+          map.insert_or_assign(key, Entry::make(key, generation));
+        }
+        for (std::uint64_t key = generation % 2; key < key_count; key += 2) {
+          map.erase(key);
+        }
+      }
+      done = true;
+    });
+
+    writer.join();
+    for (auto& reader : readers) reader.join();
+    CHECK(!failed);
+  }
+
+  SECTION("compute_if_absent runs once per key under contention") {
+    constexpr int key_count = 1'000;
+    constexpr std::size_t thread_count = 4;
+    tpp::ConcurrentHashMap<int, int> map;
+    std::atomic<int> calls{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&] {
+        for (int key = 0; key < key_count; ++key) {
+          const auto value = map.compute_if_absent(key, [&] { ++calls; return key * 2; });
+          if (value != key * 2) calls += 1'000'000;
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    CHECK(calls == key_count);
+    CHECK(map.size() == key_count);
+  }
+}
@@ -0,0 +1,78 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/eventcount.hpp"
+
+TEST_CASE("tpp::EventCount") {
+  SECTION("notification before commit is not lost") {
+    tpp::EventCount events;
+
+    const auto key = events.prepare_wait();
+    events.notify_one();
+    events.commit_wait(key);  // returns at once.
+  }
+
+  SECTION("notifying without waiters does nothing") {
+    tpp::EventCount events;
+
+    const auto key = events.prepare_wait();
+    events.cancel_wait();
+    events.notify_all();
+    CHECK(events.prepare_wait() == key);
+    events.notify_all();
+    CHECK(events.prepare_wait() != key);
+    events.cancel_wait();
+    events.cancel_wait();
+  }
+
+  SECTION("consumers block on an empty counter") {
+    constexpr std::size_t consumer_count = 3;
+    constexpr std::uint32_t count = 3'000;
+    tpp::EventCount events;
+    std::atomic<std::uint32_t> available{0};
+    std::atomic<std::uint32_t> consumed{0};
+
+    auto try_take = [&] {
+      auto current = available.load();
+      while (current != 0) {
+        if (available.compare_exchange_weak(current, current - 1)) {
+          return true;
+        }
+      }
+      return false;
+    };
+
+    std::vector<std::thread> consumers;
+    for (std::size_t index = 0; index < consumer_count; ++index) {
+      consumers.emplace_back([&] {
+        while (true) {
+          bool taken = false;
+          events.await([&] { return (taken = try_take()) || consumed.load() >= count; });
+          if (!taken) {
+            return;
+          }
+          consumed.fetch_add(1);
+          if (consumed.load() >= count) {
+            events.notify_all();
+          }
+        }
+      });
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+      available.fetch_add(1);
+      events.notify_one();
+    }
+
+    for (auto& consumer : consumers) {
+      consumer.join();
+    }
+    CHECK(consumed == count);
+    CHECK(available == 0);
+  }
+}
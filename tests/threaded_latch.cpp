@@ -0,0 +1,45 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/latch.hpp"
+
+TEMPLATE_TEST_CASE("tpp::BasicLatch", "", tpp::FutexWait, tpp::YieldWait) {
+  SECTION("count_down") {
+    tpp::BasicLatch<TestType> latch{3};
+
+    CHECK(!latch.try_wait());
+    latch.count_down(2);
+    CHECK(!latch.try_wait());
+    latch.count_down();
+    CHECK(latch.try_wait());
+    latch.wait();
+  }
+
+  SECTION("releases every waiter") {
+    constexpr std::size_t thread_count = 4;
+    tpp::BasicLatch<TestType> start{1};
+    tpp::BasicLatch<TestType> done{thread_count};
+    std::atomic<std::size_t> started{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&] {
+        start.wait();
+        started.fetch_add(1);
+        done.arrive_and_wait();
+      });
+    }
+
+    CHECK(started == 0);
+    start.count_down();
+    done.wait();
+    CHECK(started == thread_count);
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
@@ -0,0 +1,80 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/mpsc_ringbuffer.hpp"
+
+TEST_CASE("tpp::MPSCRingBuffer") {
+  SECTION("write-read") {
+    tpp::MPSCRingBuffer ring{100};
+
+    CHECK(ring.capacity() == 128);
+    CHECK(!ring.write(std::string(64, 'x').data(), 64));
+
+    std::vector<std::string> messages;
+    auto collect = [&](tpp::Span<const char> message) {
+      messages.emplace_back(message.data(), message.size());
+    };
+
+    CHECK(ring.read(collect) == 0);
+
+    // the third record straddles the end once the first two are consumed.
+    for (int round = 0; round < 4; ++round) {
+      messages.clear();
+      CHECK(ring.write("hello", 5));
+      CHECK(ring.write("", 0));
+      CHECK(ring.write(std::string(40, 'w').data(), 40));
+      CHECK(ring.read(collect) == 3);
+      REQUIRE(messages.size() == 3);
+      CHECK(messages[0] == "hello");
+      CHECK(messages[1].empty());
+      CHECK(messages[2] == std::string(40, 'w'));
+    }
+
+    CHECK(ring.read(collect) == 0);
+  }
+
+  SECTION("multi-producer-single-consumer") {
+    constexpr std::size_t producer_count = 4;
+    constexpr std::size_t count = 5'000;
+    tpp::MPSCRingBuffer ring{512};
+
+    std::vector<std::thread> producers;
+    for (std::size_t producer = 0; producer < producer_count; ++producer) {
+      producers.emplace_back([&ring, producer] {
+        for (std::size_t index = 0; index < count; ++index) {
+          const auto message = std::to_string(producer) + ':' + std::to_string(index);
+          ring.write(message.data(), message.size());
+        }
+      });
+    }
+
+    // records of one producer keep their order.
+    std::vector<std::size_t> next(producer_count, 0);
+    std::size_t total = 0;
+    bool failed = false;
+    while (total < producer_count * count) {
+      const auto read_count = ring.read([&](tpp::Span<const char> message) {
+        const std::string record(message.data(), message.size());
+        const auto separator = record.find(':');
+        const auto producer = std::stoul(record.substr(0, separator));
+        const auto index = std::stoul(record.substr(separator + 1));
+        failed |= (producer >= producer_count || next[producer] != index);
+        if (producer < producer_count) next[producer] = index + 1;
+      });
+      if (read_count == 0) {
+        std::this_thread::yield();
+      }
+      total += read_count;
+    }
+
+    for (auto& producer : producers) {
+      producer.join();
+    }
+
+    CHECK(!failed);
+    CHECK(ring.read([](tpp::Span<const char>) {}) == 0);
+  }
+}
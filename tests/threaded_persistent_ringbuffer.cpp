@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/persistent_ringbuffer.hpp"
+
+namespace {
+
+auto as_string(tpp::Span<const char> span) -> std::string {
+  return std::string(span.data(), span.size());
+}
+
+auto as_span(const std::string& str) -> tpp::Span<const char> {
+  return tpp::Span<const char>(str.data(), str.size());
+}
+
+auto make_record(std::size_t index) -> std::string {
+  return std::to_string(index) + ':' + std::string(index % 29, static_cast<char>('a' + index % 26));
+}
+
+auto temp_path(const char* name) -> std::string {
+  auto path = std::filesystem::temp_directory_path() / (name + std::to_string(::getpid()));
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+}  // namespace
+
+TEST_CASE("tpp::PersistentSPSCRingBuffer") {
+  SECTION("reopen resumes from the cursors") {
+    const auto path = temp_path("toypp-ring-reopen-");
+
+    {
+      tpp::PersistentSPSCRingBuffer ring{path, 1024};
+      for (std::size_t index = 0; index < 10; ++index) {
+        CHECK(ring.write_message(as_span(make_record(index))));
+      }
+      for (std::size_t index = 0; index < 4; ++index) {
+        CHECK(as_string(*ring.read_message()) == make_record(index));
+        ring.release_message();
+      }
+    }
+
+    {
+      // the size is taken from the file.
+      tpp::PersistentSPSCRingBuffer ring{path, 0};
+      for (std::size_t index = 4; index < 10; ++index) {
+        auto message = ring.read_message();
+        REQUIRE(message);
+        CHECK(as_string(*message) == make_record(index));
+        ring.release_message();
+      }
+      CHECK(ring.read_message() == std::nullopt);
+    }
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("a ring under 2 bytes is rejected at creation") {
+    const auto path = temp_path("toypp-ring-empty-");
+    CHECK_THROWS_AS(tpp::PersistentSPSCRingBuffer(path, 0), std::invalid_argument);
+    CHECK(!std::filesystem::exists(path));
+
+    { tpp::PersistentSPSCRingBuffer ring{path, 64}; }
+    tpp::PersistentSPSCRingBuffer ring{path, 0};
+    CHECK(ring.capacity() == 63);
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("a sized file without a header is initialized") {
+    const auto path = temp_path("toypp-ring-unset-");
+    const auto page_size = static_cast<std::uintmax_t>(::sysconf(_SC_PAGESIZE));
+    { std::ofstream create{path}; }
+    std::filesystem::resize_file(path, page_size + 256);
+
+    {
+      tpp::PersistentSPSCRingBuffer ring{path, 0};
+      CHECK(ring.capacity() == 255);
+      CHECK(ring.write_message(as_span("kept")));
+    }
+    tpp::PersistentSPSCRingBuffer ring{path, 0};
+    CHECK(as_string(*ring.read_message()) == "kept");
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("a head off the record grid is clamped, not discarded") {
+    const auto path = temp_path("toypp-ring-head-");
+    {
+      tpp::PersistentSPSCRingBuffer ring{path, 1024};
+      for (std::size_t index = 0; index < 4; ++index) {
+        CHECK(ring.write_message(as_span(make_record(index))));
+      }
+      ring.read_message();
+      ring.release_message();
+    }
+
+    {
+      // the head cursor sits 64 bytes into the header.
+      std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+      std::size_t head = 0;
+      file.seekg(64);
+      file.read(reinterpret_cast<char*>(&head), sizeof(head));
+      head += 1;
+      file.seekp(64);
+      file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    }
+
+    tpp::PersistentSPSCRingBuffer ring{path, 0};
+    for (std::size_t index = 1; index < 4; ++index) {
+      auto message = ring.read_message();
+      REQUIRE(message);
+      CHECK(as_string(*message) == make_record(index));
+      ring.release_message();
+    }
+    CHECK(ring.read_message() == std::nullopt);
+
+    std::filesystem::remove(path);
+  }
+
+  SECTION("recovers after the writer is killed mid-stream") {
+    const auto path = temp_path("toypp-ring-crash-");
+    { tpp::PersistentSPSCRingBuffer ring{path, 4096}; }
+
+    const ::pid_t pid = ::fork();
+    REQUIRE(pid != -1);
+
+    if (pid == 0) {
+      // writer: keeps publishing, dropping the oldest record when the spool is full.
+      tpp::PersistentSPSCRingBuffer ring{path, 0};
+      for (std::size_t index = 0;; ++index) {
+        const auto record = make_record(index);
+        while (!ring.write_message(as_span(record))) {
+          ring.read_message();
+          ring.release_message();
+        }
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ::kill(pid, SIGKILL);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    REQUIRE(WIFSIGNALED(status));
+
+    tpp::PersistentSPSCRingBuffer ring{path, 0};
+
+    std::size_t count = 0;
+    std::size_t expected = 0;
+    bool failed = false;
+    while (auto message = ring.read_message()) {
+      const auto record = as_string(*message);
+      const auto index = std::stoul(record.substr(0, record.find(':')));
+      if (count != 0) {
+        failed |= (index != expected);
+      }
+      failed |= (record != make_record(index));
+      expected = index + 1;
+      ++count;
+      ring.release_message();
+    }
+
+    CHECK(count > 0);
+    CHECK(!failed);
+
+    std::filesystem::remove(path);
+  }
+}
@@ -1,5 +1,12 @@
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_all.hpp>
@@ -111,3 +118,290 @@ TEST_CASE("tpp::PubSubQueue stress") {
 
   CHECK(!failed);
 }
+
+TEST_CASE("tpp::PubSubQueue bounded ring") {
+  tpp::PubSubQueue<std::size_t> pubsub_queue{8};
+  CHECK(pubsub_queue.capacity() == 8);
+
+  SECTION("wraps around") {
+    auto subscriber = pubsub_queue.subscribe();
+    for (std::size_t number = 0; number < 100; ++number) {
+      pubsub_queue.publish(number);
+      CHECK(subscriber.dequeue() == number);
+    }
+    CHECK(subscriber.dequeue() == std::nullopt);
+  }
+
+  SECTION("a dropped subscription doesn't hold the publisher back") {
+    auto subscriber = pubsub_queue.subscribe();
+    for (std::size_t number = 0; number < 8; ++number) {
+      pubsub_queue.publish(number);
+    }
+
+    {
+      auto moved = std::move(subscriber);
+      CHECK(moved.dequeue() == 0);
+    }
+
+    // would block with the subscription still registered.
+    for (std::size_t number = 8; number < 32; ++number) {
+      pubsub_queue.publish(number);
+    }
+  }
+
+  SECTION("publisher waits for the slowest subscriber") {
+    constexpr std::size_t count = 1000;
+    auto subscriber = pubsub_queue.subscribe();
+
+    std::thread publisher([&] {
+      for (std::size_t number = 0; number < count; ++number) {
+        pubsub_queue.publish(number);
+      }
+    });
+
+    std::size_t expected = 0;
+    bool failed = false;
+    while (expected != count) {
+      if (auto value = subscriber.dequeue()) {
+        failed |= (*value != expected++);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    publisher.join();
+    CHECK(!failed);
+  }
+}
+
+TEST_CASE("tpp::PubSubQueue multiple publishers") {
+  tpp::PubSubQueue<std::size_t> pubsub_queue{64};
+
+  constexpr std::size_t count = 2000;
+  constexpr std::size_t publisher_count = 4;
+
+  auto subscriber = pubsub_queue.subscribe();
+
+  std::vector<std::thread> publishers;
+  for (std::size_t index = 0; index < publisher_count; ++index) {
+    publishers.emplace_back([&pubsub_queue, index] {
+      for (std::size_t number = 0; number < count; ++number) {
+        pubsub_queue.publish(index * count + number);
+      }
+    });
+  }
+
+  // every publisher's messages arrive in its own order.
+  std::vector<std::size_t> next(publisher_count, 0);
+  bool failed = false;
+  for (std::size_t received = 0; received != count * publisher_count;) {
+    auto value = subscriber.dequeue();
+    if (!value) {
+      std::this_thread::yield();
+      continue;
+    }
+    const auto publisher = *value / count;
+    failed |= (*value % count != next[publisher]++);
+    ++received;
+  }
+
+  for (auto& publisher : publishers) {
+    publisher.join();
+  }
+  CHECK(!failed);
+  CHECK(subscriber.dequeue() == std::nullopt);
+}
+
+TEST_CASE("tpp::PubSubQueue lag policies") {
+  SECTION("block keeps everything") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{8, tpp::LagPolicy::block};
+    auto subscriber = pubsub_queue.subscribe();
+
+    for (std::size_t number = 0; number < 8; ++number) {
+      pubsub_queue.publish(number);
+    }
+    CHECK(subscriber.lag() == 8);
+    CHECK(subscriber.dequeue() == 0);
+    CHECK(subscriber.lag() == 7);
+
+    auto moved = std::move(subscriber);
+    CHECK(moved.lag() == 7);
+    CHECK(subscriber.lag() == 0);
+    CHECK(!subscriber.connected());
+  }
+
+  SECTION("drop_oldest reports the gap") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{8, tpp::LagPolicy::drop_oldest};
+    auto slow = pubsub_queue.subscribe();
+    auto fast = pubsub_queue.subscribe();
+
+    for (std::size_t number = 0; number < 20; ++number) {
+      pubsub_queue.publish(number);
+      CHECK(fast.dequeue() == number);
+      CHECK(fast.gap() == 0);
+    }
+    CHECK(slow.lag() == 8);
+
+    CHECK(slow.dequeue() == 12);
+    CHECK(slow.gap() == 12);
+    CHECK(slow.dequeue() == 13);
+    CHECK(slow.gap() == 0);
+    CHECK(slow.dropped() == 12);
+    CHECK(slow.connected());
+    CHECK(fast.dropped() == 0);
+  }
+
+  SECTION("disconnect") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{8, tpp::LagPolicy::disconnect};
+    auto slow = pubsub_queue.subscribe();
+    auto fast = pubsub_queue.subscribe();
+
+    for (std::size_t number = 0; number < 8; ++number) {
+      pubsub_queue.publish(number);
+      CHECK(fast.dequeue() == number);
+    }
+    CHECK(slow.connected());
+
+    pubsub_queue.publish(8);
+    CHECK(!slow.connected());
+    CHECK(slow.dequeue() == std::nullopt);
+    CHECK(slow.lag() == 0);
+
+    CHECK(fast.dequeue() == 8);
+    CHECK(fast.connected());
+  }
+
+  SECTION("drop_oldest under concurrency") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{16, tpp::LagPolicy::drop_oldest};
+
+    constexpr std::size_t count = 20'000;
+    constexpr std::size_t thread_count = 3;
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&failed, subscriber = pubsub_queue.subscribe()]() mutable {
+        std::size_t next = 0;
+        while (next != count) {
+          auto value = subscriber.dequeue();
+          if (!value) {
+            std::this_thread::yield();
+            continue;
+          }
+          // every message is either received or accounted for in the gap.
+          if (*value != next + subscriber.gap()) {
+            failed = true;
+            break;
+          }
+          next = *value + 1;
+        }
+      });
+    }
+
+    for (std::size_t number = 0; number < count; ++number) {
+      pubsub_queue.publish(number);
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(!failed);
+  }
+}
+
+TEST_CASE("tpp::PubSubQueue in-place reads") {
+  SECTION("dequeue_batch") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{16};
+    auto subscriber = pubsub_queue.subscribe();
+
+    for (std::size_t number = 0; number < 10; ++number) {
+      pubsub_queue.publish(number);
+    }
+
+    std::vector<std::size_t> values;
+    CHECK(subscriber.dequeue_batch(std::back_inserter(values), 4) == 4);
+    CHECK(values == std::vector<std::size_t>{0, 1, 2, 3});
+    CHECK(subscriber.dequeue_batch(std::back_inserter(values), 100) == 6);
+    CHECK(values.size() == 10);
+    CHECK(values.back() == 9);
+    CHECK(subscriber.dequeue_batch(std::back_inserter(values), 100) == 0);
+  }
+
+  SECTION("peek and advance") {
+    tpp::PubSubQueue<std::string> pubsub_queue{16, tpp::LagPolicy::drop_oldest};
+    auto subscriber = pubsub_queue.subscribe();
+
+    CHECK(subscriber.peek() == nullptr);
+    pubsub_queue.publish("first");
+    pubsub_queue.publish("second");
+
+    const auto* view = subscriber.peek();
+    REQUIRE(view);
+    CHECK(*view == "first");
+    CHECK(subscriber.peek() == view);
+
+    subscriber.advance();
+    CHECK(*subscriber.peek() == "second");
+    CHECK(subscriber.dequeue() == "second");
+    CHECK(subscriber.peek() == nullptr);
+  }
+
+  SECTION("a held peek doesn't block subscribe and unsubscribe") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{4, tpp::LagPolicy::drop_oldest};
+    auto subscriber = pubsub_queue.subscribe();
+    for (std::size_t number = 0; number < 4; ++number) {
+      pubsub_queue.publish(number);
+    }
+    REQUIRE(subscriber.peek());
+
+    // needs the peeked slot: it waits for the peek, without the registry lock.
+    std::atomic<bool> published{false};
+    std::thread publisher([&] {
+      pubsub_queue.publish(4);
+      published = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    {
+      auto late = pubsub_queue.subscribe();
+    }
+    CHECK(!published);
+
+    subscriber.advance();
+    publisher.join();
+    CHECK(published);
+    CHECK(subscriber.dequeue() == 1);
+  }
+
+  SECTION("visit move-only values") {
+    tpp::PubSubQueue<std::unique_ptr<int>> pubsub_queue{16};
+    auto subscriber_a = pubsub_queue.subscribe();
+    auto subscriber_b = pubsub_queue.subscribe();
+
+    pubsub_queue.publish(std::make_unique<int>(1));
+    pubsub_queue.publish(std::make_unique<int>(2));
+
+    int sum = 0;
+    CHECK(subscriber_a.visit([&](const std::unique_ptr<int>& value) { sum += *value; }, 8) == 2);
+    CHECK(subscriber_b.visit([&](const std::unique_ptr<int>& value) { sum += *value; }) == 1);
+    CHECK(sum == 4);
+    CHECK(subscriber_b.lag() == 1);
+  }
+
+  SECTION("throwing visitor leaves the message unread") {
+    tpp::PubSubQueue<std::size_t> pubsub_queue{16, tpp::LagPolicy::disconnect};
+    auto subscriber = pubsub_queue.subscribe();
+
+    pubsub_queue.publish(0);
+    pubsub_queue.publish(1);
+
+    std::size_t visited = 0;
+    CHECK_THROWS(subscriber.visit([&](std::size_t value) {
+      if (value == 1) {
+        throw std::runtime_error("visitor");
+      }
+      ++visited;
+    }, 8));
+    CHECK(visited == 1);
+    CHECK(subscriber.dequeue() == 1);
+  }
+}
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/semaphore.hpp"
+
+TEST_CASE("tpp::Semaphore") {
+  using namespace std::chrono_literals;
+
+  SECTION("try_acquire") {
+    tpp::Semaphore semaphore{2};
+
+    CHECK(semaphore.try_acquire());
+    CHECK(semaphore.try_acquire());
+    CHECK(!semaphore.try_acquire());
+    semaphore.release();
+    CHECK(semaphore.available() == 1);
+    CHECK(semaphore.try_acquire());
+  }
+
+  SECTION("batch acquire and release") {
+    tpp::Semaphore semaphore{0};
+
+    semaphore.release(5);
+    CHECK(!semaphore.try_acquire(6));
+    CHECK(semaphore.try_acquire(3));
+    CHECK(semaphore.available() == 2);
+    semaphore.acquire(2);
+    CHECK(semaphore.available() == 0);
+  }
+
+  SECTION("try_acquire_for times out") {
+    tpp::Semaphore semaphore{1};
+
+    CHECK(!semaphore.try_acquire_for(10ms, 2));
+    CHECK(semaphore.try_acquire_for(10ms));
+    CHECK(!semaphore.try_acquire_for(10ms));
+  }
+
+  SECTION("try_acquire_for with an endless timeout") {
+    tpp::Semaphore semaphore{0};
+    std::thread releaser([&] {
+      std::this_thread::sleep_for(5ms);
+      semaphore.release();
+    });
+    CHECK(semaphore.try_acquire_for(std::chrono::hours::max()));
+    CHECK(!semaphore.try_acquire_for(std::chrono::nanoseconds::min()));
+    releaser.join();
+  }
+
+  SECTION("wakes a parked waiter") {
+    tpp::Semaphore semaphore{0};
+    std::atomic<bool> acquired{false};
+
+    std::thread waiter([&] {
+      semaphore.acquire(3);
+      acquired = true;
+    });
+
+    semaphore.release();
+    semaphore.release();
+    std::this_thread::sleep_for(10ms);
+    CHECK(!acquired);
+    semaphore.release();
+    waiter.join();
+    CHECK(acquired);
+    CHECK(semaphore.available() == 0);
+  }
+
+  SECTION("bounds the number of holders") {
+    constexpr std::uint32_t max_holders = 2;
+    constexpr std::size_t thread_count = 6;
+    constexpr std::size_t count = 2'000;
+    tpp::Semaphore semaphore{max_holders};
+    std::atomic<std::uint32_t> holders{0};
+    std::atomic<std::uint32_t> peak{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+          semaphore.acquire();
+          const auto current = holders.fetch_add(1) + 1;
+          auto seen = peak.load();
+          while (seen < current && !peak.compare_exchange_weak(seen, current)) {}
+          if (i % 64 == 0) {
+            std::this_thread::yield();
+          }
+          holders.fetch_sub(1);
+          semaphore.release();
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK(peak <= max_holders);
+    CHECK(semaphore.available() == max_holders);
+  }
+}
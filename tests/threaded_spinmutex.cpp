@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/adaptive_mutex.hpp"
+#include "toypp/threaded/mcs_spinmutex.hpp"
+#include "toypp/threaded/shared_spinmutex.hpp"
+#include "toypp/threaded/spinmutex.hpp"
+#include "toypp/threaded/ticket_spinmutex.hpp"
+
+TEST_CASE("tpp::SpinMutex") {
+  SECTION("acquire-release") {
+    tpp::SpinMutex mutex;
+
+    mutex.acquire();
+    CHECK(!mutex.try_lock());
+    mutex.release();
+    CHECK(mutex.try_lock());
+    mutex.release();
+  }
+
+  SECTION("scoped_lock") {
+    tpp::SpinMutex mutex_a;
+    tpp::SpinMutex mutex_b;
+
+    {
+      std::scoped_lock lock{mutex_a, mutex_b};
+      CHECK(!mutex_a.try_lock());
+      CHECK(!mutex_b.try_lock());
+    }
+    CHECK(mutex_a.try_lock());
+    CHECK(mutex_b.try_lock());
+  }
+}
+
+TEMPLATE_TEST_CASE("lockable mutexes", "",
+                   tpp::SpinMutex, tpp::TicketSpinMutex, tpp::MCSSpinMutex,
+                   tpp::SharedSpinMutex, tpp::BasicSharedSpinMutex<true>, tpp::AdaptiveMutex) {
+  SECTION("try_lock") {
+    TestType mutex;
+
+    CHECK(mutex.try_lock());
+    CHECK(!mutex.try_lock());
+    mutex.unlock();
+
+    {
+      std::lock_guard lock{mutex};
+      CHECK(!mutex.try_lock());
+    }
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+  }
+
+  SECTION("nested different locks") {
+    TestType mutex_a;
+    TestType mutex_b;
+
+    mutex_a.lock();
+    mutex_b.lock();
+    mutex_a.unlock();
+    CHECK(mutex_a.try_lock());
+    CHECK(!mutex_b.try_lock());
+    mutex_b.unlock();
+    mutex_a.unlock();
+  }
+
+  SECTION("mutual exclusion") {
+    constexpr std::size_t thread_count = 4;
+    constexpr std::size_t count = 20'000;
+    TestType mutex;
+    std::uint64_t counter = 0;
+
+    std::vector<std::thread> threads;
+    for (std::size_t index = 0; index < thread_count; ++index) {
+      threads.emplace_back([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+          std::lock_guard lock{mutex};
+          ++counter;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    CHECK(counter == thread_count * count);
+  }
+}
+
+TEMPLATE_TEST_CASE("shared spin mutexes", "",
+                   tpp::SharedSpinMutex, tpp::BasicSharedSpinMutex<true>) {
+  SECTION("shared and exclusive") {
+    TestType mutex;
+
+    {
+      std::shared_lock reader_a{mutex};
+      std::shared_lock reader_b{mutex};
+      CHECK(!mutex.try_lock());
+      CHECK(mutex.try_lock_shared());
+      mutex.unlock_shared();
+    }
+
+    {
+      std::lock_guard writer{mutex};
+      CHECK(!mutex.try_lock_shared());
+      CHECK(!mutex.try_lock());
+    }
+
+    CHECK(mutex.try_lock_shared());
+    mutex.unlock_shared();
+  }
+
+  SECTION("readers never see a half-written value") {
+    constexpr std::size_t count = 5'000;
+    TestType mutex;
+    std::uint64_t first = 0;
+    std::uint64_t second = 0;
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+
+    std::vector<std::thread> readers;
+    for (int index = 0; index < 3; ++index) {
+      readers.emplace_back([&] {
+        while (!done.load(std::memory_order_relaxed)) {
+          std::shared_lock lock{mutex};
+          if (first != second) {
+            failed = true;
+          }
+        }
+      });
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+      std::lock_guard lock{mutex};
+      ++first;
+      ++second;
+    }
+    done = true;
+
+    for (auto& reader : readers) {
+      reader.join();
+    }
+    CHECK(!failed);
+    CHECK(first == count);
+  }
+}
+
+TEST_CASE("tpp::BasicSharedSpinMutex writer preference") {
+  tpp::BasicSharedSpinMutex<true> mutex;
+  mutex.lock_shared();
+
+  std::atomic<bool> acquired{false};
+  std::thread writer([&] {
+    std::lock_guard lock{mutex};
+    acquired = true;
+  });
+
+  // once the writer is waiting, new readers are held back.
+  while (mutex.try_lock_shared()) {
+    mutex.unlock_shared();
+    std::this_thread::yield();
+  }
+  CHECK(!acquired);
+
+  mutex.unlock_shared();
+  writer.join();
+  CHECK(acquired);
+}
@@ -1,9 +1,223 @@
+#include <stdexcept>
+#include <string>
 #include <thread>
 
 #include <catch2/catch_all.hpp>
 
 #include "toypp/threaded/spsc_ringbuffer.hpp"
 
+namespace {
+
+auto as_string(tpp::Span<const char> span) -> std::string {
+  return std::string(span.data(), span.size());
+}
+
+auto as_span(const std::string& str) -> tpp::Span<const char> {
+  return tpp::Span<const char>(str.data(), str.size());
+}
+
+}  // namespace
+
 TEST_CASE("tpp::SPSCRingBuffer") {
-    //
+  SECTION("read-write") {
+    tpp::SPSCRingBuffer ring{8};
+    char out[8] = {};
+
+    CHECK(ring.capacity() == 7);
+    CHECK(ring.read(out, sizeof(out)) == 0);
+
+    CHECK(ring.write("abcde", 5) == 5);
+    CHECK(ring.read(out, 3) == 3);
+    CHECK(std::string(out, 3) == "abc");
+
+    // wraps around the end of the buffer.
+    CHECK(ring.write("fghijk", 6) == 5);
+    CHECK(ring.write("x", 1) == 0);
+
+    CHECK(ring.read(out, sizeof(out)) == 7);
+    CHECK(std::string(out, 7) == "defghij");
+    CHECK(ring.read(out, sizeof(out)) == 0);
+  }
+
+  SECTION("rings under 2 bytes are rejected") {
+    CHECK_THROWS_AS(tpp::SPSCRingBuffer{0}, std::invalid_argument);
+    CHECK_THROWS_AS(tpp::SPSCRingBuffer{1}, std::invalid_argument);
+
+    tpp::SPSCRingBuffer ring{2};
+    CHECK(ring.capacity() == 1);
+    CHECK(ring.write("hello", 5) == 1);
+  }
+
+  SECTION("single-producer-single-consumer") {
+    constexpr std::size_t count = 100'000;
+    tpp::SPSCRingBuffer ring{64};
+
+    std::thread producer([&] {
+      for (std::size_t i = 0; i < count; ++i) {
+        const char byte = static_cast<char>(i % 251);
+        while (ring.write(&byte, 1) == 0) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    bool failed = false;
+    for (std::size_t i = 0; i < count;) {
+      char chunk[16];
+      const auto read_count = ring.read(chunk, sizeof(chunk));
+      if (read_count == 0) {
+        std::this_thread::yield();
+      }
+      for (std::size_t k = 0; k < read_count; ++k, ++i) {
+        failed |= (chunk[k] != static_cast<char>(i % 251));
+      }
+    }
+
+    producer.join();
+    CHECK(!failed);
+  }
+}
+
+TEST_CASE("tpp::SPSCRingBuffer framed") {
+  SECTION("write-read-release") {
+    tpp::SPSCRingBuffer ring{32};
+
+    CHECK(ring.read_message() == std::nullopt);
+
+    CHECK(ring.write_message(as_span("hello")));
+    CHECK(ring.write_message(as_span("")));
+    CHECK(ring.write_message(as_span("world")));
+
+    auto message = ring.read_message();
+    REQUIRE(message);
+    CHECK(as_string(*message) == "hello");
+
+    // not consumed until released.
+    CHECK(as_string(*ring.read_message()) == "hello");
+    ring.release_message();
+
+    message = ring.read_message();
+    REQUIRE(message);
+    CHECK(message->empty());
+    ring.release_message();
+
+    CHECK(as_string(*ring.read_message()) == "world");
+    ring.release_message();
+
+    CHECK(ring.read_message() == std::nullopt);
+  }
+
+  SECTION("all or nothing") {
+    tpp::SPSCRingBuffer ring{32};
+
+    CHECK(!ring.write_message(as_span(std::string(32, 'x'))));
+    CHECK(ring.write_message(as_span(std::string(12, 'a'))));
+    CHECK(!ring.write_message(as_span(std::string(12, 'b'))));
+    CHECK(ring.write_message(as_span(std::string(8, 'c'))));
+
+    CHECK(as_string(*ring.read_message()) == std::string(12, 'a'));
+    ring.release_message();
+    CHECK(as_string(*ring.read_message()) == std::string(8, 'c'));
+    ring.release_message();
+    CHECK(ring.read_message() == std::nullopt);
+  }
+
+  SECTION("records never split at the wrap point") {
+    tpp::SPSCRingBuffer ring{32};
+
+    CHECK(ring.write_message(as_span(std::string(8, 'a'))));   // [0, 12)
+    CHECK(ring.write_message(as_span(std::string(8, 'b'))));   // [12, 24)
+    CHECK(as_string(*ring.read_message()) == std::string(8, 'a'));
+    ring.release_message();
+
+    // 8 bytes left before the end; the record goes to the front after a skip marker.
+    CHECK(!ring.write_message(as_span(std::string(6, 'c'))));  // front is still in use.
+    CHECK(as_string(*ring.read_message()) == std::string(8, 'b'));
+    ring.release_message();
+    CHECK(ring.write_message(as_span(std::string(6, 'c'))));   // [0, 12)
+    CHECK(ring.write_message(as_span(std::string(4, 'd'))));   // [12, 20)
+
+    auto message = ring.read_message();
+    REQUIRE(message);
+    CHECK(as_string(*message) == std::string(6, 'c'));
+    ring.release_message();
+    CHECK(as_string(*ring.read_message()) == std::string(4, 'd'));
+    ring.release_message();
+    CHECK(ring.read_message() == std::nullopt);
+  }
+
+  SECTION("single-producer-single-consumer") {
+    constexpr std::size_t count = 20'000;
+    tpp::SPSCRingBuffer ring{256};
+
+    std::thread producer([&] {
+      for (std::size_t i = 0; i < count; ++i) {
+        const auto message = std::to_string(i) + std::string(i % 37, '#');
+        while (!ring.write_message(as_span(message))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    bool failed = false;
+    for (std::size_t i = 0; i < count; ++i) {
+      auto message = ring.read_message();
+      while (!message) {
+        std::this_thread::yield();
+        message = ring.read_message();
+      }
+      failed |= (as_string(*message) != std::to_string(i) + std::string(i % 37, '#'));
+      ring.release_message();
+    }
+
+    producer.join();
+    CHECK(!failed);
+  }
+}
+
+TEMPLATE_TEST_CASE("tpp::BasicSPSCRingBuffer wait strategies", "",
+                   tpp::BusySpinWait, tpp::SpinPauseWait, tpp::YieldWait, tpp::FutexWait) {
+  constexpr std::size_t count = 500;
+  tpp::BasicSPSCRingBuffer<TestType> ring{64};
+
+  SECTION("bytes") {
+    std::thread producer([&] {
+      for (std::size_t i = 0; i < count; ++i) {
+        const char byte = static_cast<char>(i % 251);
+        ring.write_wait(&byte, 1);
+      }
+    });
+
+    bool failed = false;
+    for (std::size_t i = 0; i < count;) {
+      char chunk[16];
+      const auto read_count = ring.read_wait(chunk, sizeof(chunk));
+      failed |= (read_count == 0);
+      for (std::size_t k = 0; k < read_count; ++k, ++i) {
+        failed |= (chunk[k] != static_cast<char>(i % 251));
+      }
+    }
+
+    producer.join();
+    CHECK(!failed);
+  }
+
+  SECTION("messages") {
+    CHECK(!ring.write_message_wait(as_span(std::string(64, 'x'))));
+
+    std::thread producer([&] {
+      for (std::size_t i = 0; i < count; ++i) {
+        ring.write_message_wait(as_span(std::to_string(i)));
+      }
+    });
+
+    bool failed = false;
+    for (std::size_t i = 0; i < count; ++i) {
+      failed |= (as_string(ring.read_message_wait()) != std::to_string(i));
+      ring.release_message();
+    }
+
+    producer.join();
+    CHECK(!failed);
+  }
 }
@@ -0,0 +1,64 @@
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "toypp/threaded/triplebuffer.hpp"
+
+TEST_CASE("tpp::TripleBuffer") {
+  SECTION("publish-arrive") {
+    tpp::TripleBuffer<std::vector<int>> tbuff{};
+
+    CHECK(std::addressof(tbuff.reader_buffer()) != std::addressof(tbuff.writer_buffer()));
+    CHECK(!tbuff.reader_arrive());
+
+    tbuff.writer_buffer() = {1};
+    tbuff.writer_publish();
+
+    // the writer never waits for the reader.
+    tbuff.writer_buffer() = {2};
+    tbuff.writer_publish();
+    tbuff.writer_buffer() = {3};
+
+    CHECK(tbuff.reader_arrive());
+    CHECK(tbuff.reader_buffer() == std::vector<int>{2});
+    CHECK(!tbuff.reader_arrive());
+    CHECK(tbuff.reader_buffer() == std::vector<int>{2});
+
+    tbuff.writer_publish();
+    CHECK(tbuff.reader_arrive());
+    CHECK(tbuff.reader_buffer() == std::vector<int>{3});
+    CHECK(std::addressof(tbuff.reader_buffer()) != std::addressof(tbuff.writer_buffer()));
+  }
+
+  SECTION("snapshots are complete and never go back in time") {
+    constexpr std::uint64_t count = 100'000;
+    tpp::TripleBuffer<std::vector<std::uint64_t>> tbuff{};
+
+    std::thread writer([&] {
+      for (std::uint64_t value = 1; value <= count; ++value) {
+        tbuff.writer_buffer().assign(8, value);
+        tbuff.writer_publish();
+      }
+    });
+
+    bool failed = false;
+    std::uint64_t last = 0;
+    while (last != count) {
+      if (!tbuff.reader_arrive()) {
+        std::this_thread::yield();
+        continue;
+      }
+      const auto& snapshot = tbuff.reader_buffer();
+      failed |= (snapshot.size() != 8 || snapshot.front() <= last);
+      for (auto value : snapshot) {
+        failed |= (value != snapshot.front());
+      }
+      last = snapshot.front();
+    }
+
+    writer.join();
+    CHECK(!failed);
+  }
+}